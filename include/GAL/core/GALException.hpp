@@ -6,6 +6,7 @@
 #define GAL_GAL_EXCEPTION_HPP
 
 #include <exception>
+#include <string>
 
 #include "GAL/detail/logging.hpp"
 
@@ -13,7 +14,8 @@ namespace gal
 {
 	/**
 	 * @brief Class for exceptions in GAL. This is thrown when an expected error occurs inside GAL. Also
-	 * contains a GAL ErrCode.
+	 * contains a GAL ErrCode. The message is copied, so it may come from a buffer that's freed as the exception
+	 * propagates (e.g., an OpenGL error log).
 	 */
 	class GALException : public std::exception
 	{
@@ -27,10 +29,10 @@ namespace gal
 		 * @brief Get the approximate cause of the exception.
 		 * @return A null-terminated string explaining what error happened and why.
 		 */
-		[[nodiscard]] const char* what() const noexcept override { return m_msg; }
+		[[nodiscard]] const char* what() const noexcept override { return m_msg.c_str(); }
 
 	private:
-		const char* m_msg;
+		std::string m_msg;
 	};
 
 	namespace detail
@@ -0,0 +1,416 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_GL_STATE_CACHE_HPP
+#define GAL_GL_STATE_CACHE_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace gal
+{
+	/**
+	 * @brief A shadow of the binding state of one OpenGL context: the current program, vertex array, buffer bindings
+	 * (generic and indexed), texture units and primitive restart. GAL's bind calls go through the cache of the current
+	 * context and skip the GL call when the binding wouldn't change.
+	 *
+	 * Each Window owns the cache of its context, made current with Window::makeContextCurrent(). Code that changes
+	 * bindings with raw GL calls must call invalidateGLState() afterwards, so the cache doesn't skip a bind it
+	 * shouldn't.
+	 */
+	class GLStateCache
+	{
+	public:
+		/**
+		 * @brief Use a program, unless it's already in use.
+		 * @return Whether glUseProgram() was called.
+		 */
+		bool useProgram(const ProgramID id) noexcept
+		{
+			if (!changed(m_program, id))
+				return false;
+			glUseProgram(id);
+			return true;
+		}
+
+		/**
+		 * @brief Bind a vertex array, unless it's already bound.
+		 * @return Whether glBindVertexArray() was called.
+		 */
+		bool bindVertexArray(const VertexArrayID id) noexcept
+		{
+			if (!changed(m_vertexArray, id))
+				return false;
+			glBindVertexArray(id);
+			// The element array buffer binding belongs to the vertex array.
+			m_buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = Unknown;
+			return true;
+		}
+
+		/**
+		 * @brief Bind a buffer to a target, unless it's already bound to it.
+		 * @return Whether glBindBuffer() was called.
+		 */
+		bool bindBuffer(const GLenum target, const BufferID id) noexcept
+		{
+			if (!changed(m_buffers[bufferSlot(target)], id))
+				return false;
+			glBindBuffer(target, id);
+			return true;
+		}
+
+		/**
+		 * @brief Bind a whole buffer to an indexed target, unless it's already bound there.
+		 * @return Whether glBindBufferBase() was called.
+		 */
+		bool bindBufferBase(const GLenum target, const GLuint index, const BufferID id) noexcept
+		{
+			if (!changed(indexedBinding(target, index), {id, 0, WholeBuffer}))
+				return false;
+			glBindBufferBase(target, index, id);
+			// Binding to an indexed target also binds to the generic one.
+			m_buffers[bufferSlot(target)] = id;
+			return true;
+		}
+
+		/**
+		 * @brief Bind a range of a buffer to an indexed target, unless that range is already bound there.
+		 * @return Whether glBindBufferRange() was called.
+		 */
+		bool bindBufferRange(const GLenum target, const GLuint index, const BufferID id, const GLintptr offset,
+			const GLsizeiptr size) noexcept
+		{
+			if (!changed(indexedBinding(target, index), {id, offset, size}))
+				return false;
+			glBindBufferRange(target, index, id, offset, size);
+			m_buffers[bufferSlot(target)] = id;
+			return true;
+		}
+
+		/**
+		 * @brief Bind a texture to a texture unit, unless it's already bound there.
+		 * @return Whether glBindTextureUnit() was called.
+		 */
+		bool bindTextureUnit(const GLuint unit, const TextureID id) noexcept
+		{
+			if (!changed(textureUnit(unit), id))
+				return false;
+			glBindTextureUnit(unit, id);
+			return true;
+		}
+
+		/**
+		 * @brief Bind textures to consecutive texture units with a single glBindTextures() call, unless every unit
+		 * already has its texture bound. ids may be nullptr to unbind the units.
+		 * @return Whether glBindTextures() was called.
+		 */
+		bool bindTextures(const GLuint first, const GLsizei count, const TextureID* ids) noexcept
+		{
+			bool anyChanged = false;
+			for (GLsizei i = 0; i < count; ++i)
+			{
+				// Like glBindTextures(), nullptr unbinds every unit.
+				const TextureID id = ids ? ids[i] : 0;
+				TextureID& bound = textureUnit(first + static_cast<GLuint>(i));
+				anyChanged |= bound != id;
+				bound = id;
+			}
+
+			if (!anyChanged)
+			{
+				++m_elidedBinds;
+				return false;
+			}
+			glBindTextures(first, count, ids);
+			++m_issuedBinds;
+			return true;
+		}
+
+		/**
+		 * @brief Enable or disable GL_PRIMITIVE_RESTART_FIXED_INDEX, unless it's already in that state.
+		 * @return Whether glEnable() or glDisable() was called.
+		 */
+		bool setPrimitiveRestart(const bool enabled) noexcept
+		{
+			if (!changed(m_primitiveRestart, enabled ? 1u : 0u))
+				return false;
+			if (enabled)
+				glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+			else
+				glDisable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+			return true;
+		}
+
+		/**
+		 * @brief Forget every binding, so the next bind of anything is issued. Call after changing bindings with raw
+		 * GL calls or other libraries.
+		 */
+		void invalidate() noexcept
+		{
+			m_program = Unknown;
+			m_vertexArray = Unknown;
+			m_buffers.fill(Unknown);
+			for (auto& bindings : m_indexedBuffers)
+				bindings.clear();
+			m_textureUnits.clear();
+			m_primitiveRestart = Unknown;
+		}
+
+		/**
+		 * @brief Forget a program that's being deleted, so a new program given the same ID is used again.
+		 */
+		void forgetProgram(const ProgramID id) noexcept
+		{
+			if (m_program == id)
+				m_program = Unknown;
+		}
+
+		/**
+		 * @brief Forget a vertex array that's being deleted.
+		 */
+		void forgetVertexArray(const VertexArrayID id) noexcept
+		{
+			if (m_vertexArray == id)
+			{
+				m_vertexArray = Unknown;
+				m_buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = Unknown;
+			}
+		}
+
+		/**
+		 * @brief Forget every binding of a buffer that's being deleted.
+		 */
+		void forgetBuffer(const BufferID id) noexcept
+		{
+			for (BufferID& bound : m_buffers)
+				if (bound == id)
+					bound = Unknown;
+			for (auto& bindings : m_indexedBuffers)
+				for (IndexedBinding& binding : bindings)
+					if (binding.buffer == id)
+						binding = {};
+		}
+
+		/**
+		 * @brief Forget every binding of a texture that's being deleted.
+		 */
+		void forgetTexture(const TextureID id) noexcept
+		{
+			for (TextureID& bound : m_textureUnits)
+				if (bound == id)
+					bound = Unknown;
+		}
+
+		/**
+		 * @brief Get the number of bind calls issued to OpenGL.
+		 */
+		[[nodiscard]] std::size_t getIssuedBindCount() const noexcept { return m_issuedBinds; }
+		/**
+		 * @brief Get the number of bind calls skipped because nothing would have changed.
+		 */
+		[[nodiscard]] std::size_t getElidedBindCount() const noexcept { return m_elidedBinds; }
+		/**
+		 * @brief Reset the counters returned by getIssuedBindCount() and getElidedBindCount().
+		 */
+		void resetStats() noexcept
+		{
+			m_issuedBinds = 0;
+			m_elidedBinds = 0;
+		}
+
+	private:
+		// Value of a binding the cache doesn't know, which never matches a real object.
+		static constexpr GLuint Unknown = ~GLuint{0};
+		// Size of a binding made with glBindBufferBase().
+		static constexpr GLsizeiptr WholeBuffer = -1;
+
+		struct IndexedBinding
+		{
+			BufferID buffer = Unknown;
+			GLintptr offset = 0;
+			GLsizeiptr size = 0;
+
+			bool operator!=(const IndexedBinding& other) const noexcept
+			{
+				return buffer != other.buffer || offset != other.offset || size != other.size;
+			}
+		};
+
+		GLuint m_program = Unknown;
+		GLuint m_vertexArray = Unknown;
+		// Generic bindings of every buffer target, in the order of bufferSlot().
+		std::array<BufferID, 15> m_buffers = filledWithUnknown<15>();
+		// Indexed bindings of the targets that have them, in the order of indexedSlot(), grown as indices are bound.
+		std::array<std::vector<IndexedBinding>, 4> m_indexedBuffers;
+		std::vector<TextureID> m_textureUnits;
+		GLuint m_primitiveRestart = Unknown;
+
+		std::size_t m_issuedBinds = 0;
+		std::size_t m_elidedBinds = 0;
+
+		template<std::size_t N>
+		static std::array<GLuint, N> filledWithUnknown() noexcept
+		{
+			std::array<GLuint, N> array{};
+			array.fill(Unknown);
+			return array;
+		}
+
+		template<typename T>
+		bool changed(T& bound, const T& value) noexcept
+		{
+			if (!(bound != value))
+			{
+				++m_elidedBinds;
+				return false;
+			}
+			bound = value;
+			++m_issuedBinds;
+			return true;
+		}
+
+		static std::size_t indexedSlot(const GLenum target) noexcept
+		{
+			switch (target)
+			{
+				case GL_ATOMIC_COUNTER_BUFFER: return 0;
+				case GL_SHADER_STORAGE_BUFFER: return 1;
+				case GL_TRANSFORM_FEEDBACK_BUFFER: return 2;
+				default: return 3; // GL_UNIFORM_BUFFER
+			}
+		}
+
+		static std::size_t bufferSlot(const GLenum target) noexcept
+		{
+			switch (target)
+			{
+				case GL_ARRAY_BUFFER: return 4;
+				case GL_COPY_READ_BUFFER: return 5;
+				case GL_COPY_WRITE_BUFFER: return 6;
+				case GL_DISPATCH_INDIRECT_BUFFER: return 7;
+				case GL_DRAW_INDIRECT_BUFFER: return 8;
+				case GL_ELEMENT_ARRAY_BUFFER: return 9;
+				case GL_PIXEL_PACK_BUFFER: return 10;
+				case GL_PIXEL_UNPACK_BUFFER: return 11;
+				case GL_QUERY_BUFFER: return 12;
+				case GL_TEXTURE_BUFFER: return 13;
+				case GL_PARAMETER_BUFFER: return 14;
+				default: return indexedSlot(target);
+			}
+		}
+
+		IndexedBinding& indexedBinding(const GLenum target, const GLuint index)
+		{
+			std::vector<IndexedBinding>& bindings = m_indexedBuffers[indexedSlot(target)];
+			if (index >= bindings.size())
+				bindings.resize(index + 1);
+			return bindings[index];
+		}
+
+		TextureID& textureUnit(const GLuint unit)
+		{
+			if (unit >= m_textureUnits.size())
+				m_textureUnits.resize(unit + 1, Unknown);
+			return m_textureUnits[unit];
+		}
+	};
+
+	namespace detail
+	{
+		/// State cache of the context current on this thread, or nullptr if none was made current through GAL.
+		inline thread_local GLStateCache* g_currentGLState = nullptr;
+	}
+
+	/**
+	 * @brief Get the state cache of the context current on this thread.
+	 * @return The cache, or nullptr if no context was made current with Window::makeContextCurrent(), in which case
+	 * GAL's bind calls always call OpenGL.
+	 */
+	[[nodiscard]] inline GLStateCache* getCurrentGLState() noexcept { return detail::g_currentGLState; }
+
+	/**
+	 * @brief Forget the bindings cached for the context current on this thread. Call after changing bindings with raw
+	 * GL calls or other libraries, so GAL doesn't skip a bind that's needed.
+	 */
+	inline void invalidateGLState() noexcept
+	{
+		if (detail::g_currentGLState)
+			detail::g_currentGLState->invalidate();
+	}
+
+	namespace detail
+	{
+		// Binds that go through the current context's state cache, or straight to OpenGL if there isn't one.
+
+		inline void useProgram(const ProgramID id) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->useProgram(id);
+			else
+				glUseProgram(id);
+		}
+
+		inline void bindVertexArray(const VertexArrayID id) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->bindVertexArray(id);
+			else
+				glBindVertexArray(id);
+		}
+
+		inline void bindBuffer(const GLenum target, const BufferID id) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->bindBuffer(target, id);
+			else
+				glBindBuffer(target, id);
+		}
+
+		inline void bindBufferBase(const GLenum target, const GLuint index, const BufferID id) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->bindBufferBase(target, index, id);
+			else
+				glBindBufferBase(target, index, id);
+		}
+
+		inline void bindBufferRange(const GLenum target, const GLuint index, const BufferID id, const GLintptr offset,
+			const GLsizeiptr size) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->bindBufferRange(target, index, id, offset, size);
+			else
+				glBindBufferRange(target, index, id, offset, size);
+		}
+
+		inline void bindTextureUnit(const GLuint unit, const TextureID id) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->bindTextureUnit(unit, id);
+			else
+				glBindTextureUnit(unit, id);
+		}
+
+		inline void bindTextures(const GLuint first, const GLsizei count, const TextureID* ids) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->bindTextures(first, count, ids);
+			else
+				glBindTextures(first, count, ids);
+		}
+
+		inline void setPrimitiveRestart(const bool enabled) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->setPrimitiveRestart(enabled);
+			else if (enabled)
+				glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+			else
+				glDisable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+		}
+	}
+}
+
+#endif //GAL_GL_STATE_CACHE_HPP
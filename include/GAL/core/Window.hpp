@@ -5,6 +5,8 @@
 #ifndef GAL_WINDOW_HPP
 #define GAL_WINDOW_HPP
 
+#include <memory>
+
 #include <GAL/detail/UniqueHandle.hpp>
 
 #include "GAL/system/time.hpp"
@@ -68,6 +70,15 @@ namespace gal
 			detail::logDecreaseIndent();
 		}
 
+		Window(Window&&) noexcept = default;
+		Window& operator=(Window&&) noexcept = default;
+
+		~Window() override
+		{
+			if (detail::g_currentGLState == m_glState.get())
+				detail::g_currentGLState = nullptr;
+		}
+
 		/**
 		 * @brief Get the GLFWwindow* for this window for use with GLFW functions.
 		 * @return The GLFWwindow* of the window.
@@ -122,12 +133,20 @@ namespace gal
 		void setSize(const int width, const int height) const noexcept { glfwSetWindowSize(getHandle(), width, height); }
 
 		/**
-		 * @brief Make this window's context current, so later OpenGL calls use this window's context.
+		 * @brief Get the state cache of this window's context, which GAL's bind calls go through while the context is
+		 * current.
+		 */
+		[[nodiscard]] GLStateCache& getGLState() const noexcept { return *m_glState; }
+
+		/**
+		 * @brief Make this window's context current, so later OpenGL calls use this window's context, and GAL's bind
+		 * calls on this thread use its state cache.
 		 * Also initializes glad the first time this function is run after a call to gal::init().
 		 */
 		void makeContextCurrent() const
 		{
 			glfwMakeContextCurrent(getWindowHandle());
+			detail::g_currentGLState = m_glState.get();
 
 			if (!detail::g_postGLInitialized)
 				detail::postGLInit();
@@ -165,6 +184,9 @@ namespace gal
 		}
 
 	private:
+		// Owned through a pointer so it stays put when the window is moved.
+		std::unique_ptr<GLStateCache> m_glState = std::make_unique<GLStateCache>();
+
 		/**
 		 * @brief Reset any window hints set in the constructor to their defaults in the event an error is thrown.
 		 */
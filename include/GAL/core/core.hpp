@@ -7,6 +7,7 @@
 
 #include "enums.hpp"
 #include "GALException.hpp"
+#include "GLStateCache.hpp"
 #include "init.hpp"
 #include "keyboard.hpp"
 #include "Window.hpp"
@@ -17,19 +17,38 @@ namespace gal
 		MapBufferFailed, // Failed to map buffer.
 		UnmapBufferFailed, // Failed to unmap buffer.
 
+		// Culling.
+		MissingCullingBounds, // Attempted to cull more draws than there are bounding spheres.
+
 		// Init.
 		GLFWInitFailed, // Failed to initialize GLFW.
 		GLADInitFailed, // Failed to initialize GLAD.
 
+		// Mesh.
+		InvalidMeshData, // Attempted to process a mesh whose vertex or index data is malformed.
+
 		// Program.
 		CreateProgramFailed, // Failed to create program.
 		ProgramLinkFailed, // Failed to link program.
 		NonExistentShaderUniform, // Attempted to set non-existent shader uniform.
 
+		// Program pipeline.
+		CreateProgramPipelineFailed, // Failed to create program pipeline.
+
+		// Program library.
+		TooManyProgramKeywords, // Attempted to create a program library with more than 64 keywords.
+
 		// Shader.
 		CreateShaderFailed, // Failed to create shader.
 		ShaderCompilationFailed, // Failed to compile shader.
 		ShaderFileReadFailed, // Failed to read shader source file.
+		ShaderIncludeFailed, // Failed to resolve an #include directive in a shader source.
+
+		// Texture.
+		CreateTextureFailed, // Failed to create texture.
+
+		// Uniform ring.
+		UniformRingOverflow, // Attempted to allocate more from a uniform ring in one frame than its frame capacity.
 
 		// Vertex array.
 		CreateVertexArrayFailed, // Failed to create vertex array.
@@ -38,6 +57,10 @@ namespace gal
 		VertexAttributeIndexOutOfRange, // Attempted to add a vertex attribute with an index that was out of range
 		                                // (> GL_MAX_VERTEX_ATTRIBS - 1).
 
+		// Vertex pulling.
+		InvalidVertexPullingLayout, // Attempted to add a pulled vertex attribute that isn't 4-byte aligned or doesn't
+		                            // fit inside the vertex stride.
+
 		// Window.
 		CreateWindowFailed, // Failed to create window.
 	};
@@ -55,21 +78,36 @@ namespace gal
 			case ErrCode::MapBufferFailed: return "MapBufferFailed";
 			case ErrCode::UnmapBufferFailed: return "UnmapBufferFailed";
 
+			case ErrCode::MissingCullingBounds: return "MissingCullingBounds";
+
 			case ErrCode::GLFWInitFailed: return "GLFWInitFailed";
 			case ErrCode::GLADInitFailed: return "GLADInitFailed";
 
+			case ErrCode::InvalidMeshData: return "InvalidMeshData";
+
 			case ErrCode::CreateProgramFailed: return "CreateProgramFailed";
 			case ErrCode::ProgramLinkFailed: return "ProgramLinkFailed";
 			case ErrCode::NonExistentShaderUniform: return "NonExistentShaderUniform";
 
+			case ErrCode::CreateProgramPipelineFailed: return "CreateProgramPipelineFailed";
+
+			case ErrCode::TooManyProgramKeywords: return "TooManyProgramKeywords";
+
 			case ErrCode::CreateShaderFailed: return "CreateShaderFailed";
 			case ErrCode::ShaderCompilationFailed: return "ShaderCompilationFailed";
 			case ErrCode::ShaderFileReadFailed: return "ShaderFileReadFailed";
+			case ErrCode::ShaderIncludeFailed: return "ShaderIncludeFailed";
+
+			case ErrCode::CreateTextureFailed: return "CreateTextureFailed";
+
+			case ErrCode::UniformRingOverflow: return "UniformRingOverflow";
 
 			case ErrCode::CreateVertexArrayFailed: return "CreateVertexArrayFailed";
 			case ErrCode::VertexBufferIndexOutOfRange: return "VertexBufferIndexOutOfRange";
 			case ErrCode::VertexAttributeIndexOutOfRange: return "VertexAttributeIndexOutOfRange";
 
+			case ErrCode::InvalidVertexPullingLayout: return "InvalidVertexPullingLayout";
+
 			case ErrCode::CreateWindowFailed: return "CreateWindowFailed";
 			
 			default:
@@ -91,6 +129,31 @@ namespace gal
 		Fragment       = GL_FRAGMENT_SHADER
 	};
 
+	/**
+	 * @brief Bitfield of the stages of a program pipeline. Combine stages with |.
+	 * Values align with GL enums of the same names.
+	 */
+	enum class ProgramStage : GLbitfield
+	{
+		Vertex         = GL_VERTEX_SHADER_BIT,
+		TessControl    = GL_TESS_CONTROL_SHADER_BIT,
+		TessEvaluation = GL_TESS_EVALUATION_SHADER_BIT,
+		Geometry       = GL_GEOMETRY_SHADER_BIT,
+		Fragment       = GL_FRAGMENT_SHADER_BIT,
+		Compute        = GL_COMPUTE_SHADER_BIT,
+		All            = GL_ALL_SHADER_BITS,
+	};
+
+	[[nodiscard]] constexpr ProgramStage operator|(const ProgramStage a, const ProgramStage b) noexcept
+	{
+		return static_cast<ProgramStage>(static_cast<GLbitfield>(a) | static_cast<GLbitfield>(b));
+	}
+
+	[[nodiscard]] constexpr ProgramStage operator&(const ProgramStage a, const ProgramStage b) noexcept
+	{
+		return static_cast<ProgramStage>(static_cast<GLbitfield>(a) & static_cast<GLbitfield>(b));
+	}
+
 	/**
 	 * @brief Enum of all \b non-indexed buffer targets.
 	 * Values align with GL enums of the same names.
@@ -103,6 +166,7 @@ namespace gal
 		DispatchIndirect  = GL_DISPATCH_INDIRECT_BUFFER,
 		DrawIndirect      = GL_DRAW_INDIRECT_BUFFER,
 		ElementArray      = GL_ELEMENT_ARRAY_BUFFER,
+		Parameter         = GL_PARAMETER_BUFFER,
 		PixelPack         = GL_PIXEL_PACK_BUFFER,
 		PixelUnpack       = GL_PIXEL_UNPACK_BUFFER,
 		Query             = GL_QUERY_BUFFER,
@@ -117,6 +181,15 @@ namespace gal
 		Uniform           = GL_UNIFORM_BUFFER
 	};
 
+	/**
+	 * @brief Enum of the standard memory layouts of uniform blocks and shader storage blocks.
+	 */
+	enum class BlockLayout
+	{
+		Std140, // layout(std140), the only standard layout of uniform blocks.
+		Std430, // layout(std430), which packs arrays and matrices tighter, for shader storage blocks.
+	};
+
 	/**
 	 * @brief Enum of all possible buffer usages.
 	 * Values align with GL enums of the same names.
@@ -136,6 +209,125 @@ namespace gal
 		StreamCopy  = GL_STREAM_COPY
 	};
 
+	/**
+	 * @brief Enum of all primitive types that can be drawn.
+	 * Values align with GL enums of the same names.
+	 */
+	enum class DrawMode : GLenum
+	{
+		Points                 = GL_POINTS,
+		Lines                  = GL_LINES,
+		LineLoop               = GL_LINE_LOOP,
+		LineStrip              = GL_LINE_STRIP,
+		LinesAdjacency         = GL_LINES_ADJACENCY,
+		LineStripAdjacency     = GL_LINE_STRIP_ADJACENCY,
+		Triangles              = GL_TRIANGLES,
+		TriangleStrip          = GL_TRIANGLE_STRIP,
+		TriangleFan            = GL_TRIANGLE_FAN,
+		TrianglesAdjacency     = GL_TRIANGLES_ADJACENCY,
+		TriangleStripAdjacency = GL_TRIANGLE_STRIP_ADJACENCY,
+		Patches                = GL_PATCHES,
+	};
+
+	/**
+	 * @brief Enum of all index types usable in element buffers.
+	 * Values align with GL enums of the same names.
+	 */
+	enum class IndexType : GLenum
+	{
+		UnsignedShort = GL_UNSIGNED_SHORT,
+		UnsignedInt   = GL_UNSIGNED_INT,
+	};
+
+	/**
+	 * @brief Enum of the GLSL types a vertex attribute fetched through vertex pulling can have.
+	 */
+	enum class PulledAttributeType
+	{
+		Float, Vec2, Vec3, Vec4,
+		Int, IVec2, IVec3, IVec4,
+		UInt, UVec2, UVec3, UVec4,
+	};
+
+	/**
+	 * @brief Enum of the ways a float vertex attribute can be packed to save bandwidth. See packVertices() and
+	 * VertexArray::vertexAttributePackedFormat().
+	 */
+	enum class VertexAttributePacking
+	{
+		Float32,           // Unpacked GL_FLOAT.
+		Half,              // GL_HALF_FLOAT.
+		Snorm16,           // Normalized GL_SHORT, for values in [-1, 1].
+		Unorm8,            // Normalized GL_UNSIGNED_BYTE, for values in [0, 1] such as colors.
+		OctahedralSnorm16, // Unit vectors octahedral encoded into two normalized GL_SHORTs.
+		Int2101010Rev,     // Normalized GL_INT_2_10_10_10_REV, for 4-component vectors such as tangents.
+	};
+
+	/**
+	 * @brief Enum of the ways a resource can be accessed after a shader wrote to it incoherently (through image
+	 * stores, storage blocks or atomic counters). Each value is the memory barrier bit that makes such writes
+	 * visible to accesses of that kind. Values align with GL enums of the same names.
+	 */
+	enum class ResourceAccess : GLbitfield
+	{
+		VertexAttribArray  = GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT,
+		ElementArray       = GL_ELEMENT_ARRAY_BARRIER_BIT,
+		Uniform            = GL_UNIFORM_BARRIER_BIT,
+		TextureFetch       = GL_TEXTURE_FETCH_BARRIER_BIT,
+		ShaderImageAccess  = GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,
+		Command            = GL_COMMAND_BARRIER_BIT,
+		PixelBuffer        = GL_PIXEL_BUFFER_BARRIER_BIT,
+		TextureUpdate      = GL_TEXTURE_UPDATE_BARRIER_BIT,
+		BufferUpdate       = GL_BUFFER_UPDATE_BARRIER_BIT,
+		Framebuffer        = GL_FRAMEBUFFER_BARRIER_BIT,
+		TransformFeedback  = GL_TRANSFORM_FEEDBACK_BARRIER_BIT,
+		AtomicCounter      = GL_ATOMIC_COUNTER_BARRIER_BIT,
+		ShaderStorage      = GL_SHADER_STORAGE_BARRIER_BIT,
+		ClientMappedBuffer = GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT,
+		QueryBuffer        = GL_QUERY_BUFFER_BARRIER_BIT,
+	};
+
+	/**
+	 * @brief Bitfield of flags for immutable buffer storage (see Buffer::allocateStorage()). Combine flags with |.
+	 * Values align with GL enums of the same names.
+	 */
+	enum class BufferStorageFlags : GLbitfield
+	{
+		None           = 0,
+		DynamicStorage = GL_DYNAMIC_STORAGE_BIT,
+		MapRead        = GL_MAP_READ_BIT,
+		MapWrite       = GL_MAP_WRITE_BIT,
+		MapPersistent  = GL_MAP_PERSISTENT_BIT,
+		MapCoherent    = GL_MAP_COHERENT_BIT,
+		ClientStorage  = GL_CLIENT_STORAGE_BIT,
+	};
+
+	[[nodiscard]] constexpr BufferStorageFlags operator|(const BufferStorageFlags a, const BufferStorageFlags b) noexcept
+	{
+		return static_cast<BufferStorageFlags>(static_cast<GLbitfield>(a) | static_cast<GLbitfield>(b));
+	}
+
+	/**
+	 * @brief Bitfield of flags for mapping a range of a buffer (see Buffer::mapRange()). Combine flags with |.
+	 * Values align with GL enums of the same names.
+	 */
+	enum class BufferMapFlags : GLbitfield
+	{
+		Read             = GL_MAP_READ_BIT,
+		Write            = GL_MAP_WRITE_BIT,
+		Persistent       = GL_MAP_PERSISTENT_BIT,
+		Coherent         = GL_MAP_COHERENT_BIT,
+		InvalidateRange  = GL_MAP_INVALIDATE_RANGE_BIT,
+		InvalidateBuffer = GL_MAP_INVALIDATE_BUFFER_BIT,
+		FlushExplicit    = GL_MAP_FLUSH_EXPLICIT_BIT,
+		Unsynchronized   = GL_MAP_UNSYNCHRONIZED_BIT,
+	};
+
+	[[nodiscard]] constexpr BufferMapFlags operator|(const BufferMapFlags a, const BufferMapFlags b) noexcept
+	{
+		return static_cast<BufferMapFlags>(static_cast<GLbitfield>(a) | static_cast<GLbitfield>(b));
+	}
+
 	enum class BufferAccessPolicy : GLbitfield
 	{
 		ReadOnly  = GL_READ_ONLY,
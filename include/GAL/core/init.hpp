@@ -7,6 +7,11 @@
 
 #include "GAL/detail/ResourceRegistry.hpp"
 
+// The vendored glad loads no extensions, so GL_KHR_parallel_shader_compile is loaded by hand.
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace gal
 {
 	namespace detail
@@ -17,6 +22,30 @@ namespace gal
 		inline bool g_initialized = false;
 		inline bool g_postGLInitialized = false;
 
+		inline bool g_parallelShaderCompileSupported = false;
+		inline void (GLAD_API_PTR *g_glMaxShaderCompilerThreads)(GLuint count) = nullptr;
+
+		inline GLint g_uniformBufferOffsetAlignment = 0;
+
+		/**
+		 * @brief Load GL_KHR_parallel_shader_compile (or its ARB equivalent) if the driver supports it.
+		 */
+		inline void loadParallelShaderCompile()
+		{
+			const char* procName = nullptr;
+			if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+				procName = "glMaxShaderCompilerThreadsKHR";
+			else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+				procName = "glMaxShaderCompilerThreadsARB";
+
+			g_glMaxShaderCompilerThreads = procName ?
+				reinterpret_cast<void (GLAD_API_PTR *)(GLuint)>(glfwGetProcAddress(procName)) : nullptr;
+			g_parallelShaderCompileSupported = g_glMaxShaderCompilerThreads != nullptr;
+
+			if (g_parallelShaderCompileSupported)
+				logInfo("Loaded parallel shader compile extension.");
+		}
+
 		/**
 		 * @brief Initialization that can only be done after an OpenGL context has been created. Mainly initialization
 		 * of glad.
@@ -39,6 +68,9 @@ namespace gal
 				logWarnStart() << "Initialized GLAD with a different version of OpenGL (" << major << "." << minor <<
 						") than was specified in the call to gal::init()." << logWarnEnd;
 
+			loadParallelShaderCompile();
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &g_uniformBufferOffsetAlignment);
+
 			g_postGLInitialized = true;
 
 			logInfo("Successfully post-GL initialized GAL.");
@@ -107,6 +139,10 @@ namespace gal
 		detail::g_openGLVersionMinor = -1;
 
 		detail::g_postGLInitialized = false;
+		detail::g_parallelShaderCompileSupported = false;
+		detail::g_glMaxShaderCompilerThreads = nullptr;
+		detail::g_uniformBufferOffsetAlignment = 0;
+		detail::g_currentGLState = nullptr;
 
 		detail::g_resourceRegistry.destroyAll();
 		detail::logInfo("Destroyed all GAL resources.");
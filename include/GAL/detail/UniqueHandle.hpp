@@ -59,7 +59,7 @@ namespace gal::detail
 
 				if (handleValid())
 				{
-					g_resourceRegistry.unregister(ResourceRegistry::handleToVoidPtr(other.m_handle));
+					g_resourceRegistry.unregister(static_cast<void*>(&other.m_handle));
 					other.m_handle = Invalid;
 					register_();
 				}
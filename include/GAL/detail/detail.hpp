@@ -6,6 +6,7 @@
 #define GAL_DETAIL_HPP
 
 #include "logging.hpp"
+#include "parallel.hpp"
 #include "ResourceRegistry.hpp"
 #include "UniqueHandle.hpp"
 
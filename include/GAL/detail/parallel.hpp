@@ -0,0 +1,47 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_PARALLEL_HPP
+#define GAL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace gal::detail
+{
+	/**
+	 * @brief Call a function for every index in [0, count) on a pool of threads, and return once every call is done.
+	 * Indices are handed out one at a time, so uneven work is balanced across the threads.
+	 * @param count Number of indices.
+	 * @param threadCount Number of threads to use, including the calling thread. 0 uses one per hardware thread.
+	 * @param function Called with each index. It must not throw; store errors per index and handle them afterwards.
+	 */
+	template<typename Function>
+	void parallelFor(const std::size_t count, const unsigned threadCount, const Function& function)
+	{
+		std::atomic<std::size_t> next = 0;
+		const auto worker = [&]()
+		{
+			for (std::size_t i = next++; i < count; i = next++)
+				function(i);
+		};
+
+		const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+		const auto workerCount = static_cast<unsigned>(std::min<std::size_t>(
+			threadCount == 0 ? hardwareThreads : threadCount, count));
+
+		std::vector<std::thread> threads;
+		for (unsigned t = 1; t < workerCount; ++t)
+			threads.emplace_back(worker);
+		worker();
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+}
+
+#endif //GAL_PARALLEL_HPP
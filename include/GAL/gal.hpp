@@ -27,6 +27,7 @@
 #include "debug/debug.hpp"
 #include "detail/detail.hpp"
 #include "graphics/graphics.hpp"
+#include "mesh/mesh.hpp"
 #include "system/system.hpp"
 
 #endif //GAL_GAL_HPP
\ No newline at end of file
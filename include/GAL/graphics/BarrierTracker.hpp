@@ -0,0 +1,258 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_BARRIER_TRACKER_HPP
+#define GAL_BARRIER_TRACKER_HPP
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Buffer.hpp"
+#include "Program.hpp"
+
+namespace gal
+{
+	namespace detail
+	{
+		/**
+		 * @brief Get the name of a single memory barrier bit, for logging.
+		 */
+		inline const char* barrierBitName(const GLbitfield bit) noexcept
+		{
+			switch (bit)
+			{
+				case GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT: return "GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT";
+				case GL_ELEMENT_ARRAY_BARRIER_BIT: return "GL_ELEMENT_ARRAY_BARRIER_BIT";
+				case GL_UNIFORM_BARRIER_BIT: return "GL_UNIFORM_BARRIER_BIT";
+				case GL_TEXTURE_FETCH_BARRIER_BIT: return "GL_TEXTURE_FETCH_BARRIER_BIT";
+				case GL_SHADER_IMAGE_ACCESS_BARRIER_BIT: return "GL_SHADER_IMAGE_ACCESS_BARRIER_BIT";
+				case GL_COMMAND_BARRIER_BIT: return "GL_COMMAND_BARRIER_BIT";
+				case GL_PIXEL_BUFFER_BARRIER_BIT: return "GL_PIXEL_BUFFER_BARRIER_BIT";
+				case GL_TEXTURE_UPDATE_BARRIER_BIT: return "GL_TEXTURE_UPDATE_BARRIER_BIT";
+				case GL_BUFFER_UPDATE_BARRIER_BIT: return "GL_BUFFER_UPDATE_BARRIER_BIT";
+				case GL_FRAMEBUFFER_BARRIER_BIT: return "GL_FRAMEBUFFER_BARRIER_BIT";
+				case GL_TRANSFORM_FEEDBACK_BARRIER_BIT: return "GL_TRANSFORM_FEEDBACK_BARRIER_BIT";
+				case GL_ATOMIC_COUNTER_BARRIER_BIT: return "GL_ATOMIC_COUNTER_BARRIER_BIT";
+				case GL_SHADER_STORAGE_BARRIER_BIT: return "GL_SHADER_STORAGE_BARRIER_BIT";
+				case GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT: return "GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT";
+				case GL_QUERY_BUFFER_BARRIER_BIT: return "GL_QUERY_BUFFER_BARRIER_BIT";
+				default: return "unknown barrier bit";
+			}
+		}
+	}
+
+	/**
+	 * @brief Tracks which buffers and images shaders have written to incoherently, and issues the minimal
+	 * glMemoryBarrier() before they're next accessed: only the bits for the ways they're accessed, and only if no
+	 * barrier with those bits has been issued since the write.
+	 *
+	 * Declare every shader write with writeBuffer()/writeImage() and every access that may depend on one with
+	 * readBuffer()/readImage(), then call flush() right before the draw or dispatch making the accesses (dispatch()
+	 * and dispatchIndirect() do this themselves). Barriers declared for the same command are merged into one call.
+	 *
+	 * @code
+	 * gal::BarrierTracker barriers;
+	 * barriers.writeBuffer(particles);
+	 * barriers.dispatch(simulate, groups);
+	 * barriers.readBuffer(particles, gal::ResourceAccess::VertexAttribArray);
+	 * barriers.flush(); // Issues GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT.
+	 * particleVao.draw(...);
+	 * @endcode
+	 */
+	class BarrierTracker
+	{
+	public:
+		/**
+		 * @brief Create a barrier tracker with nothing written.
+		 * @param verbose Whether to log every barrier inserted or elided. Requires GAL_INFO_LOGGING.
+		 */
+		explicit BarrierTracker(const bool verbose = false) noexcept : m_verbose(verbose) { }
+
+		/**
+		 * @brief Declare that the next command writes to a buffer through a shader. If an earlier write through the
+		 * same kind of access hasn't been made visible yet, the barrier for it is added first.
+		 * @param buffer ID of the buffer.
+		 * @param access How the shader writes to it: ShaderStorage, AtomicCounter or ShaderImageAccess (for buffer
+		 * textures).
+		 */
+		void writeBuffer(const BufferID buffer, const ResourceAccess access = ResourceAccess::ShaderStorage)
+		{
+			write(bufferKey(buffer), "buffer", buffer, access);
+		}
+		/**
+		 * @brief Declare that the next command writes to a buffer through a shader.
+		 */
+		void writeBuffer(const Buffer& buffer, const ResourceAccess access = ResourceAccess::ShaderStorage)
+		{
+			writeBuffer(buffer.getID(), access);
+		}
+
+		/**
+		 * @brief Declare that the next command writes to a texture through image stores. If an earlier image store to
+		 * it hasn't been made visible yet, the barrier for it is added first.
+		 * @param texture ID of the texture.
+		 */
+		void writeImage(const TextureID texture)
+		{
+			write(imageKey(texture), "image", texture, ResourceAccess::ShaderImageAccess);
+		}
+
+		/**
+		 * @brief Declare that the next command accesses a buffer, adding the barrier needed if a shader wrote to it
+		 * and the write hasn't been made visible to this kind of access yet.
+		 * @param buffer ID of the buffer.
+		 * @param access How the buffer is accessed.
+		 */
+		void readBuffer(const BufferID buffer, const ResourceAccess access)
+		{
+			read(bufferKey(buffer), "buffer", buffer, access);
+		}
+		/**
+		 * @brief Declare that the next command accesses a buffer.
+		 */
+		void readBuffer(const Buffer& buffer, const ResourceAccess access) { readBuffer(buffer.getID(), access); }
+
+		/**
+		 * @brief Declare that the next command accesses a texture, adding the barrier needed if a shader stored to it
+		 * and the stores haven't been made visible to this kind of access yet.
+		 * @param texture ID of the texture.
+		 * @param access How the texture is accessed, e.g. TextureFetch for sampling.
+		 */
+		void readImage(const TextureID texture, const ResourceAccess access)
+		{
+			read(imageKey(texture), "image", texture, access);
+		}
+
+		/**
+		 * @brief Issue every barrier added since the last flush in a single glMemoryBarrier() call, if any. Call right
+		 * before the command the accesses and writes were declared for.
+		 */
+		void flush()
+		{
+			if (m_pendingBits)
+			{
+				glMemoryBarrier(m_pendingBits);
+
+				++m_epoch;
+				for (std::size_t i = 0; i < m_issuedEpochs.size(); ++i)
+					if (m_pendingBits >> i & 1)
+						m_issuedEpochs[i] = m_epoch;
+
+				++m_insertedBarriers;
+				m_pendingBits = 0;
+			}
+
+			// The writes happen in the command issued next, after any barrier just issued.
+			for (const std::uint64_t key : m_pendingWrites)
+				m_writes[key] = m_epoch;
+			m_pendingWrites.clear();
+		}
+
+		/**
+		 * @brief Issue pending barriers and dispatch a compute program.
+		 */
+		void dispatch(const Program& program, const GLuint groupsX, const GLuint groupsY = 1,
+			const GLuint groupsZ = 1)
+		{
+			flush();
+			program.dispatch(groupsX, groupsY, groupsZ);
+		}
+
+		/**
+		 * @brief Declare the read of the indirect buffer, issue pending barriers and dispatch a compute program with
+		 * work group counts read from the buffer.
+		 */
+		void dispatchIndirect(const Program& program, const Buffer& buffer, const GLintptr offset = 0)
+		{
+			readBuffer(buffer, ResourceAccess::Command);
+			flush();
+			program.dispatchIndirect(buffer, offset);
+		}
+
+		/**
+		 * @brief Forget every tracked write, e.g. after glFinish() or when resources are recreated.
+		 */
+		void clear() noexcept
+		{
+			m_writes.clear();
+			m_pendingWrites.clear();
+			m_pendingBits = 0;
+		}
+
+		/**
+		 * @brief Get the number of glMemoryBarrier() calls issued.
+		 */
+		[[nodiscard]] std::size_t getInsertedBarrierCount() const noexcept { return m_insertedBarriers; }
+		/**
+		 * @brief Get the number of accesses to written resources that needed no barrier, because one issued earlier
+		 * already made the write visible to them.
+		 */
+		[[nodiscard]] std::size_t getElidedBarrierCount() const noexcept { return m_elidedBarriers; }
+		/**
+		 * @brief Reset the counters returned by getInsertedBarrierCount() and getElidedBarrierCount().
+		 */
+		void resetStats() noexcept
+		{
+			m_insertedBarriers = 0;
+			m_elidedBarriers = 0;
+		}
+
+	private:
+		bool m_verbose;
+		// Number of barriers issued so far, and the value it had when the last barrier including each bit was issued.
+		std::uint64_t m_epoch = 0;
+		std::array<std::uint64_t, 16> m_issuedEpochs{};
+		// Value of m_epoch when each written resource was last written.
+		std::unordered_map<std::uint64_t, std::uint64_t> m_writes;
+		// Barrier bits and writes declared for the next command.
+		GLbitfield m_pendingBits = 0;
+		std::vector<std::uint64_t> m_pendingWrites;
+
+		std::size_t m_insertedBarriers = 0;
+		std::size_t m_elidedBarriers = 0;
+
+		static std::uint64_t bufferKey(const BufferID id) noexcept { return id; }
+		static std::uint64_t imageKey(const TextureID id) noexcept { return std::uint64_t{1} << 32 | id; }
+
+		static std::size_t bitIndex(GLbitfield bit) noexcept
+		{
+			std::size_t index = 0;
+			while (bit >>= 1)
+				++index;
+			return index;
+		}
+
+		void read(const std::uint64_t key, const char* kind, const GLuint id, const ResourceAccess access)
+		{
+			const auto it = m_writes.find(key);
+			if (it == m_writes.end())
+				return;
+
+			const auto bit = static_cast<GLbitfield>(access);
+			if (m_issuedEpochs[bitIndex(bit)] > it->second)
+			{
+				++m_elidedBarriers;
+				if (m_verbose)
+					detail::logInfoStart() << "Elided " << detail::barrierBitName(bit) << " before access to " << kind <<
+						" " << id << ", already made visible." << detail::logInfoEnd;
+				return;
+			}
+
+			if (m_verbose && !(m_pendingBits & bit))
+				detail::logInfoStart() << "Inserting " << detail::barrierBitName(bit) << " before access to " << kind <<
+					" " << id << "." << detail::logInfoEnd;
+			m_pendingBits |= bit;
+		}
+
+		void write(const std::uint64_t key, const char* kind, const GLuint id, const ResourceAccess access)
+		{
+			read(key, kind, id, access);
+			m_pendingWrites.push_back(key);
+		}
+	};
+}
+
+#endif //GAL_BARRIER_TRACKER_HPP
@@ -0,0 +1,233 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_BLOCK_LAYOUT_HPP
+#define GAL_BLOCK_LAYOUT_HPP
+
+#include <array>
+#include <cstddef>
+
+namespace gal
+{
+	/**
+	 * @brief Describes one member of a C++ struct mirroring a uniform block or shader storage block. Create them with
+	 * GAL_BLOCK_MEMBER(), list them in declaration order, and check the list against the block's layout at compile time
+	 * with matchesBlockLayout() and against the linked program with Program::validateUniformBlock() or
+	 * Program::validateStorageBlock().
+	 */
+	struct BlockMember
+	{
+		/// Name of the member in GLSL, which must match its name in the C++ struct.
+		const char* name;
+		/// GLSL type of the member, or of its elements if it's an array (e.g., GL_FLOAT_VEC3).
+		GLenum type;
+		/// Byte offset of the member within the C++ struct.
+		std::size_t offset;
+		/// Number of array elements, or 0 if the member isn't an array.
+		std::size_t arraySize;
+		/// Size of the member in C++, or of one of its elements if it's an array.
+		std::size_t elementSize;
+	};
+
+	/**
+	 * @brief Where a block layout places a member, as computed by getBlockMemberLayout().
+	 */
+	struct BlockMemberLayout
+	{
+		/// Base alignment of the member. Its offset is a multiple of this.
+		std::size_t alignment;
+		/// Number of bytes the member takes up, including padding inside arrays and matrices.
+		std::size_t size;
+		/// Distance between array elements, or 0 if the member isn't an array.
+		std::size_t arrayStride;
+		/// Distance between matrix columns, or 0 if the member isn't a matrix.
+		std::size_t matrixStride;
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Maps a C++ type to the GLSL type it mirrors in a block. Only 32-bit scalars, vectors of them and float
+		 * matrices are supported; bool is not, since its size differs between C++ and GLSL.
+		 */
+		template<typename T>
+		struct BlockMemberType;
+
+		template<> struct BlockMemberType<GLfloat> { static constexpr GLenum type = GL_FLOAT; };
+		template<> struct BlockMemberType<glm::vec2> { static constexpr GLenum type = GL_FLOAT_VEC2; };
+		template<> struct BlockMemberType<glm::vec3> { static constexpr GLenum type = GL_FLOAT_VEC3; };
+		template<> struct BlockMemberType<glm::vec4> { static constexpr GLenum type = GL_FLOAT_VEC4; };
+		template<> struct BlockMemberType<GLint> { static constexpr GLenum type = GL_INT; };
+		template<> struct BlockMemberType<glm::ivec2> { static constexpr GLenum type = GL_INT_VEC2; };
+		template<> struct BlockMemberType<glm::ivec3> { static constexpr GLenum type = GL_INT_VEC3; };
+		template<> struct BlockMemberType<glm::ivec4> { static constexpr GLenum type = GL_INT_VEC4; };
+		template<> struct BlockMemberType<GLuint> { static constexpr GLenum type = GL_UNSIGNED_INT; };
+		template<> struct BlockMemberType<glm::uvec2> { static constexpr GLenum type = GL_UNSIGNED_INT_VEC2; };
+		template<> struct BlockMemberType<glm::uvec3> { static constexpr GLenum type = GL_UNSIGNED_INT_VEC3; };
+		template<> struct BlockMemberType<glm::uvec4> { static constexpr GLenum type = GL_UNSIGNED_INT_VEC4; };
+		template<> struct BlockMemberType<glm::mat2> { static constexpr GLenum type = GL_FLOAT_MAT2; };
+		template<> struct BlockMemberType<glm::mat3> { static constexpr GLenum type = GL_FLOAT_MAT3; };
+		template<> struct BlockMemberType<glm::mat4> { static constexpr GLenum type = GL_FLOAT_MAT4; };
+		template<> struct BlockMemberType<glm::mat2x3> { static constexpr GLenum type = GL_FLOAT_MAT2x3; };
+		template<> struct BlockMemberType<glm::mat3x2> { static constexpr GLenum type = GL_FLOAT_MAT3x2; };
+		template<> struct BlockMemberType<glm::mat2x4> { static constexpr GLenum type = GL_FLOAT_MAT2x4; };
+		template<> struct BlockMemberType<glm::mat4x2> { static constexpr GLenum type = GL_FLOAT_MAT4x2; };
+		template<> struct BlockMemberType<glm::mat3x4> { static constexpr GLenum type = GL_FLOAT_MAT3x4; };
+		template<> struct BlockMemberType<glm::mat4x3> { static constexpr GLenum type = GL_FLOAT_MAT4x3; };
+
+		template<typename T>
+		struct BlockMemberArray
+		{
+			using Element = T;
+			static constexpr std::size_t size = 0;
+		};
+
+		template<typename T, std::size_t N>
+		struct BlockMemberArray<T[N]>
+		{
+			using Element = T;
+			static constexpr std::size_t size = N;
+		};
+
+		template<typename T, std::size_t N>
+		struct BlockMemberArray<std::array<T, N>>
+		{
+			using Element = T;
+			static constexpr std::size_t size = N;
+		};
+
+		template<typename T>
+		constexpr BlockMember makeBlockMember(const char* name, const std::size_t offset) noexcept
+		{
+			using Element = typename BlockMemberArray<T>::Element;
+			return {name, BlockMemberType<Element>::type, offset, BlockMemberArray<T>::size, sizeof(Element)};
+		}
+
+		/**
+		 * @brief Get the number of columns and rows of a GLSL type. Scalars and vectors have one column.
+		 * @return {0, 0} if the type isn't one BlockMember supports.
+		 */
+		constexpr std::array<std::size_t, 2> getBlockTypeShape(const GLenum type) noexcept
+		{
+			switch (type)
+			{
+				case GL_FLOAT: case GL_INT: case GL_UNSIGNED_INT: return {1, 1};
+				case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_UNSIGNED_INT_VEC2: return {1, 2};
+				case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_UNSIGNED_INT_VEC3: return {1, 3};
+				case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_UNSIGNED_INT_VEC4: return {1, 4};
+				case GL_FLOAT_MAT2: return {2, 2};
+				case GL_FLOAT_MAT3: return {3, 3};
+				case GL_FLOAT_MAT4: return {4, 4};
+				case GL_FLOAT_MAT2x3: return {2, 3};
+				case GL_FLOAT_MAT3x2: return {3, 2};
+				case GL_FLOAT_MAT2x4: return {2, 4};
+				case GL_FLOAT_MAT4x2: return {4, 2};
+				case GL_FLOAT_MAT3x4: return {3, 4};
+				case GL_FLOAT_MAT4x3: return {4, 3};
+				default: return {0, 0};
+			}
+		}
+
+		constexpr std::size_t alignUp(const std::size_t value, const std::size_t alignment) noexcept
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	/**
+	 * @brief Compute where a block layout places a member of the given type, following the rules of the OpenGL
+	 * specification (section 7.6.2.2). Matrices are column-major.
+	 * @param type GLSL type of the member, or of its elements if it's an array.
+	 * @param arraySize Number of array elements, or 0 if the member isn't an array.
+	 * @param layout The block layout.
+	 */
+	[[nodiscard]] constexpr BlockMemberLayout getBlockMemberLayout(const GLenum type, const std::size_t arraySize,
+		const BlockLayout layout) noexcept
+	{
+		const auto [columns, rows] = detail::getBlockTypeShape(type);
+
+		// Scalars align to their size, two-component vectors to twice that, and three- and four-component vectors to
+		// four times that.
+		std::size_t alignment = rows == 3 ? 16 : rows * 4;
+		std::size_t size = rows * 4;
+		std::size_t matrixStride = 0;
+		std::size_t arrayStride = 0;
+
+		// Matrices are laid out as an array of column vectors.
+		if (columns > 1)
+		{
+			matrixStride = layout == BlockLayout::Std140 ? detail::alignUp(alignment, 16) : alignment;
+			alignment = matrixStride;
+			size = columns * matrixStride;
+		}
+
+		// std140 rounds the alignment of array elements (including matrix columns, above) up to that of a vec4.
+		if (arraySize > 0)
+		{
+			if (layout == BlockLayout::Std140)
+				alignment = detail::alignUp(alignment, 16);
+			arrayStride = detail::alignUp(size, alignment);
+			size = arrayStride * arraySize;
+		}
+
+		return {alignment, size, arrayStride, matrixStride};
+	}
+
+	/**
+	 * @brief Find the first member of a C++ struct that isn't where a block layout places it, e.g. because the struct
+	 * lacks padding, or an array of float or vec3 (or a mat3) was used where GLSL pads each element to 16 bytes.
+	 * @param members Every member of the struct, in declaration order.
+	 * @param count Number of members.
+	 * @param layout The block layout.
+	 * @return Index of the first mismatched member, or count if every member matches.
+	 */
+	[[nodiscard]] constexpr std::size_t findBlockLayoutMismatch(const BlockMember* members, const std::size_t count,
+		const BlockLayout layout) noexcept
+	{
+		std::size_t end = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const BlockMember& member = members[i];
+			const BlockMemberLayout expected = getBlockMemberLayout(member.type, member.arraySize, layout);
+			const std::size_t expectedElementSize = member.arraySize > 0 ? expected.arrayStride : expected.size;
+
+			if (expected.size == 0 || member.offset != detail::alignUp(end, expected.alignment) ||
+				member.elementSize != expectedElementSize)
+				return i;
+
+			end = member.offset + expected.size;
+		}
+
+		return count;
+	}
+
+	/**
+	 * @brief Check at compile time that a C++ struct matches a block layout, e.g.
+	 * @code
+	 * struct Material { glm::vec4 albedo; float roughness; float metallic; };
+	 * constexpr gal::BlockMember materialMembers[] = {
+	 *     GAL_BLOCK_MEMBER(Material, albedo), GAL_BLOCK_MEMBER(Material, roughness),
+	 *     GAL_BLOCK_MEMBER(Material, metallic)};
+	 * static_assert(gal::matchesBlockLayout(materialMembers, gal::BlockLayout::Std140));
+	 * @endcode
+	 * @param members Every member of the struct, in declaration order.
+	 * @param layout The block layout.
+	 */
+	template<std::size_t N>
+	[[nodiscard]] constexpr bool matchesBlockLayout(const BlockMember (&members)[N], const BlockLayout layout) noexcept
+	{
+		return findBlockLayoutMismatch(members, N, layout) == N;
+	}
+}
+
+/**
+ * @brief Describe a member of a C++ struct mirroring a uniform or storage block as a gal::BlockMember. Usable in
+ * constant expressions.
+ * @param Struct The struct type. Must be standard-layout.
+ * @param member Name of the member, which must also be its name in GLSL.
+ */
+#define GAL_BLOCK_MEMBER(Struct, member) \
+	::gal::detail::makeBlockMember<decltype(Struct::member)>(#member, offsetof(Struct, member))
+
+#endif //GAL_BLOCK_LAYOUT_HPP
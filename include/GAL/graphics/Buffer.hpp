@@ -11,6 +11,8 @@ namespace gal
 	{
 		inline void bufferDeleter(const BufferID id) noexcept
 		{
+			if (g_currentGLState)
+				g_currentGLState->forgetBuffer(id);
 			glDeleteBuffers(1, &id);
 		}
 
@@ -50,20 +52,37 @@ namespace gal
 		[[nodiscard]] BufferID getID() const noexcept { return getHandle(); }
 
 		/**
-		 * @brief Bind the buffer to the given target.
+		 * @brief Bind the buffer to the given target. Does nothing if it's already bound there.
 		 * @param target Target to bind the buffer to.
 		 */
-		void bind(const BufferTarget target) const noexcept { glBindBuffer(static_cast<GLenum>(target), getHandle()); }
+		void bind(const BufferTarget target) const noexcept
+		{
+			detail::bindBuffer(static_cast<GLenum>(target), getHandle());
+		}
 
 		/**
-		 * @brief Bind the buffer to an indexed target.
+		 * @brief Bind the buffer to an indexed target. Does nothing if it's already bound there.
 		 * @param target Target to bind the buffer to.
 		 * @param index Index to bind the buffer to.
 		 */
 		void bindIndexed(const IndexedBufferTarget target, const GLuint index) const noexcept
 		{
 			// TODO: index bounds checking.
-			glBindBufferBase(static_cast<GLenum>(target), index, getHandle());
+			detail::bindBufferBase(static_cast<GLenum>(target), index, getHandle());
+		}
+
+		/**
+		 * @brief Bind a range of the buffer to an indexed target. Does nothing if the range is already bound there.
+		 * @param target Target to bind the buffer to.
+		 * @param index Index to bind the buffer to.
+		 * @param offset Offset where the range begins. For IndexedBufferTarget::Uniform, must be a multiple of
+		 * GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+		 * @param size Size of the range in bytes.
+		 */
+		void bindIndexedRange(const IndexedBufferTarget target, const GLuint index, const GLintptr offset,
+			const GLsizeiptr size) const noexcept
+		{
+			detail::bindBufferRange(static_cast<GLenum>(target), index, getHandle(), offset, size);
 		}
 
 		/**
@@ -121,6 +140,19 @@ namespace gal
 			glNamedBufferData(getHandle(), size, nullptr, static_cast<GLenum>(usage));
 		}
 
+		/**
+		 * @brief Allocate immutable storage for this buffer, optionally filled with the given data. Unlike allocate(),
+		 * the buffer's size can never change afterwards, which allows it to stay mapped while it's used (see
+		 * BufferStorageFlags::MapPersistent).
+		 * @param size Size to allocate in bytes.
+		 * @param data Pointer to data to fill the buffer with, or nullptr to leave the contents undefined.
+		 * @param flags How the storage may be accessed.
+		 */
+		void allocateStorage(const GLsizeiptr size, const void* data, const BufferStorageFlags flags) const noexcept
+		{
+			glNamedBufferStorage(getHandle(), size, data, static_cast<GLbitfield>(flags));
+		}
+
 		/**
 		 * @brief Allocate the given amount of memory in VRAM for this buffer with the given usage hint and fill it with
 		 * the given data.
@@ -211,6 +243,23 @@ namespace gal
 			return data;
 		}
 
+		/**
+		 * @brief Get a pointer that you can use to directly read and/or write to a portion of the buffer, with full
+		 * control over how it's mapped, e.g. persistently.
+		 * @param offset Offset where the mapped portion begins.
+		 * @param length Length of the mapped portion in bytes.
+		 * @param flags How the portion is mapped.
+		 * @return A pointer to the mapped memory.
+		 * @throws ErrCode::MapBufferFailed If mapping the buffer fails for any reason.
+		 */
+		[[nodiscard]] void* mapRange(const GLintptr offset, const GLsizeiptr length, const BufferMapFlags flags) const
+		{
+			void* data = glMapNamedBufferRange(getHandle(), offset, length, static_cast<GLbitfield>(flags));
+			if (!data)
+				detail::throwErr(ErrCode::MapBufferFailed, "Failed to map buffer.");
+			return data;
+		}
+
 		/**
 		 * @brief Unmap the buffer.
 		 * @throws ErrCode::UnmapBufferFailed If unmapping the buffer fails for any reason.
@@ -0,0 +1,324 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_DRAW_INDIRECT_BUFFER_HPP
+#define GAL_DRAW_INDIRECT_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "Buffer.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief Parameters of one indexed draw in an indirect buffer, laid out as glMultiDrawElementsIndirect() reads
+	 * them.
+	 */
+	struct DrawElementsIndirectCommand
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	/**
+	 * @brief Parameters of one non-indexed draw in an indirect buffer, laid out as glMultiDrawArraysIndirect() reads
+	 * them.
+	 */
+	struct DrawArraysIndirectCommand
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint first;
+		GLuint baseInstance;
+	};
+
+	/**
+	 * @brief Builds a frame's draws as indirect commands, along with data for each draw (e.g. its transform and
+	 * material) in a shader storage buffer, and submits all the indexed draws with one glMultiDrawElementsIndirect()
+	 * call and all the non-indexed ones with one glMultiDrawArraysIndirect() call.
+	 *
+	 * Each instance of each draw gets its own per-draw data slot, in the order the draws were added, and every draw's
+	 * baseInstance is the slot of its first instance. Shaders find an instance's data at
+	 * perDraw[gl_BaseInstance + gl_InstanceID] (GLSL 4.60), which is just perDraw[gl_BaseInstance] for draws of one
+	 * instance. gl_DrawID counts from 0 in each call, so it matches the draw index only if the buffer holds a single
+	 * kind of draw and no draw is instanced. Note that baseInstance also offsets instanced vertex attributes.
+	 *
+	 * All indexed draws share the element buffer of the vertex array bound when they're submitted, and all draws share
+	 * its vertex buffers, so meshes drawn together must be packed into the same buffers (use baseVertex and firstIndex
+	 * to pick them out).
+	 *
+	 * @code
+	 * gal::DrawIndirectBuffer draws{sizeof(PerDraw)};
+	 * // Each frame:
+	 * draws.clear();
+	 * for (const auto& object : objects)
+	 *     draws.setPerDraw(draws.addElements(object.indexCount, object.firstIndex, object.baseVertex), object.perDraw);
+	 * draws.upload();
+	 * draws.bindPerDraw(0); // layout(std430, binding = 0) readonly buffer PerDraws { PerDraw perDraw[]; };
+	 * program.use();
+	 * vertexArray.bind();
+	 * draws.drawElements(gal::DrawMode::Triangles, gal::IndexType::UnsignedInt);
+	 * @endcode
+	 */
+	class DrawIndirectBuffer
+	{
+	public:
+		/**
+		 * @brief Create an empty indirect draw builder.
+		 * @param perDrawStride Size in bytes of each draw's data, as laid out in the shader storage block (std430), or
+		 * 0 if draws have no data.
+		 * @throws ErrCode::CreateBufferFailed If creating the buffers fails.
+		 */
+		explicit DrawIndirectBuffer(const std::size_t perDrawStride = 0) : m_perDrawStride(perDrawStride) { }
+
+		/**
+		 * @brief Remove every draw, e.g. at the start of a frame. Keeps the allocated memory.
+		 */
+		void clear() noexcept
+		{
+			m_elementCommands.clear();
+			m_arrayCommands.clear();
+			m_perDraw.clear();
+			m_slotCount = 0;
+		}
+
+		/**
+		 * @brief Add an indexed draw.
+		 * @param count Number of indices.
+		 * @param firstIndex Index of the first index in the element buffer.
+		 * @param baseVertex Value added to every index.
+		 * @param instanceCount Number of instances to draw, each of which gets its own per-draw data slot.
+		 * @return The draw's baseInstance, i.e., the slot of its first instance's data.
+		 */
+		GLuint addElements(const GLuint count, const GLuint firstIndex = 0, const GLint baseVertex = 0,
+			const GLuint instanceCount = 1)
+		{
+			const GLuint baseInstance = reserveSlots(instanceCount);
+			m_elementCommands.push_back({count, instanceCount, firstIndex, baseVertex, baseInstance});
+			return baseInstance;
+		}
+
+		/**
+		 * @brief Add a non-indexed draw.
+		 * @param count Number of vertices.
+		 * @param first Index of the first vertex.
+		 * @param instanceCount Number of instances to draw, each of which gets its own per-draw data slot.
+		 * @return The draw's baseInstance, i.e., the slot of its first instance's data.
+		 */
+		GLuint addArrays(const GLuint count, const GLuint first = 0, const GLuint instanceCount = 1)
+		{
+			const GLuint baseInstance = reserveSlots(instanceCount);
+			m_arrayCommands.push_back({count, instanceCount, first, baseInstance});
+			return baseInstance;
+		}
+
+		/**
+		 * @brief Set the data of one instance of a draw.
+		 * @param slot The draw's baseInstance, as returned by addElements() or addArrays(), plus the index of the
+		 * instance.
+		 * @param data The data. Must be no larger than the per-draw stride.
+		 */
+		template<typename T>
+		void setPerDraw(const GLuint slot, const T& data) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Per-draw data must be trivially copyable.");
+			std::memcpy(m_perDraw.data() + slot * m_perDrawStride, &data, std::min(sizeof(T), m_perDrawStride));
+		}
+
+		/**
+		 * @brief Upload the commands and per-draw data. Each upload reallocates the buffers' storage, so the driver
+		 * can hand out fresh memory instead of waiting for the GPU to finish with the last frame's.
+		 */
+		void upload()
+		{
+			const std::size_t elementBytes = m_elementCommands.size() * sizeof(DrawElementsIndirectCommand);
+			const std::size_t arrayBytes = m_arrayCommands.size() * sizeof(DrawArraysIndirectCommand);
+
+			m_uploadBuffer.resize(elementBytes + arrayBytes);
+			if (elementBytes)
+				std::memcpy(m_uploadBuffer.data(), m_elementCommands.data(), elementBytes);
+			if (arrayBytes)
+				std::memcpy(m_uploadBuffer.data() + elementBytes, m_arrayCommands.data(), arrayBytes);
+
+			m_commandBuffer.allocateAndWrite(m_uploadBuffer, BufferUsage::StreamDraw);
+			if (m_perDrawStride)
+				m_perDrawBuffer.allocateAndWrite(m_perDraw, BufferUsage::StreamDraw);
+		}
+
+		/**
+		 * @brief Bind the per-draw data to a shader storage buffer binding index.
+		 * @param binding The binding index.
+		 */
+		void bindPerDraw(const GLuint binding) const noexcept
+		{
+			m_perDrawBuffer.bindIndexed(IndexedBufferTarget::ShaderStorage, binding);
+		}
+
+		/**
+		 * @brief Submit every indexed draw with one glMultiDrawElementsIndirect() call, using the program and vertex
+		 * array currently bound.
+		 * @param mode Primitive type of every draw.
+		 * @param indexType Type of the indices in the element buffer.
+		 */
+		void drawElements(const DrawMode mode, const IndexType indexType) const noexcept
+		{
+			if (m_elementCommands.empty())
+				return;
+			m_commandBuffer.bind(BufferTarget::DrawIndirect);
+			glMultiDrawElementsIndirect(static_cast<GLenum>(mode), static_cast<GLenum>(indexType), nullptr,
+				static_cast<GLsizei>(m_elementCommands.size()), 0);
+		}
+
+		/**
+		 * @brief Submit every non-indexed draw with one glMultiDrawArraysIndirect() call, using the program and vertex
+		 * array currently bound.
+		 * @param mode Primitive type of every draw.
+		 */
+		void drawArrays(const DrawMode mode) const noexcept
+		{
+			if (m_arrayCommands.empty())
+				return;
+			m_commandBuffer.bind(BufferTarget::DrawIndirect);
+			glMultiDrawArraysIndirect(static_cast<GLenum>(mode), reinterpret_cast<const void*>(getArrayCommandOffset()),
+				static_cast<GLsizei>(m_arrayCommands.size()), 0);
+		}
+
+		/**
+		 * @brief Submit indexed draws with glMultiDrawElementsIndirectCount(), which reads the number of draws from a
+		 * buffer, e.g. one written by a culling compute shader.
+		 * @param mode Primitive type of every draw.
+		 * @param indexType Type of the indices in the element buffer.
+		 * @param commands Buffer holding the DrawElementsIndirectCommand records. Bound to BufferTarget::DrawIndirect.
+		 * @param countBuffer Buffer holding the GLuint number of draws. Bound to BufferTarget::Parameter.
+		 * @param countOffset Offset of the draw count in countBuffer. Must be a multiple of 4.
+		 * @param maxDrawCount Maximum number of draws to submit, whatever the count.
+		 * @param commandOffset Offset of the first command in commands.
+		 */
+		static void drawElementsCount(const DrawMode mode, const IndexType indexType, const Buffer& commands,
+			const Buffer& countBuffer, const GLintptr countOffset, const GLsizei maxDrawCount,
+			const GLintptr commandOffset = 0) noexcept
+		{
+			commands.bind(BufferTarget::DrawIndirect);
+			countBuffer.bind(BufferTarget::Parameter);
+			glMultiDrawElementsIndirectCount(static_cast<GLenum>(mode), static_cast<GLenum>(indexType),
+				reinterpret_cast<const void*>(commandOffset), countOffset, maxDrawCount, 0);
+		}
+
+		/**
+		 * @brief Submit this buffer's indexed draws with glMultiDrawElementsIndirectCount(), submitting only as many
+		 * as a buffer says.
+		 */
+		void drawElementsCount(const DrawMode mode, const IndexType indexType, const Buffer& countBuffer,
+			const GLintptr countOffset) const noexcept
+		{
+			drawElementsCount(mode, indexType, m_commandBuffer, countBuffer, countOffset,
+				static_cast<GLsizei>(m_elementCommands.size()));
+		}
+
+		/**
+		 * @brief Submit non-indexed draws with glMultiDrawArraysIndirectCount(), which reads the number of draws from a
+		 * buffer.
+		 * @param mode Primitive type of every draw.
+		 * @param commands Buffer holding the DrawArraysIndirectCommand records. Bound to BufferTarget::DrawIndirect.
+		 * @param countBuffer Buffer holding the GLuint number of draws. Bound to BufferTarget::Parameter.
+		 * @param countOffset Offset of the draw count in countBuffer. Must be a multiple of 4.
+		 * @param maxDrawCount Maximum number of draws to submit, whatever the count.
+		 * @param commandOffset Offset of the first command in commands.
+		 */
+		static void drawArraysCount(const DrawMode mode, const Buffer& commands, const Buffer& countBuffer,
+			const GLintptr countOffset, const GLsizei maxDrawCount, const GLintptr commandOffset = 0) noexcept
+		{
+			commands.bind(BufferTarget::DrawIndirect);
+			countBuffer.bind(BufferTarget::Parameter);
+			glMultiDrawArraysIndirectCount(static_cast<GLenum>(mode), reinterpret_cast<const void*>(commandOffset),
+				countOffset, maxDrawCount, 0);
+		}
+
+		/**
+		 * @brief Submit this buffer's non-indexed draws with glMultiDrawArraysIndirectCount(), submitting only as many
+		 * as a buffer says.
+		 */
+		void drawArraysCount(const DrawMode mode, const Buffer& countBuffer, const GLintptr countOffset) const noexcept
+		{
+			drawArraysCount(mode, m_commandBuffer, countBuffer, countOffset,
+				static_cast<GLsizei>(m_arrayCommands.size()), getArrayCommandOffset());
+		}
+
+		/**
+		 * @brief Get the number of draws added, indexed and non-indexed.
+		 */
+		[[nodiscard]] GLuint getDrawCount() const noexcept
+		{
+			return static_cast<GLuint>(m_elementCommands.size() + m_arrayCommands.size());
+		}
+		/**
+		 * @brief Get the number of per-draw data slots reserved, one per instance of every draw.
+		 */
+		[[nodiscard]] GLuint getSlotCount() const noexcept { return m_slotCount; }
+		/**
+		 * @brief Get the indexed draws added.
+		 */
+		[[nodiscard]] const std::vector<DrawElementsIndirectCommand>& getElementCommands() const noexcept
+		{
+			return m_elementCommands;
+		}
+		/**
+		 * @brief Get the non-indexed draws added.
+		 */
+		[[nodiscard]] const std::vector<DrawArraysIndirectCommand>& getArrayCommands() const noexcept
+		{
+			return m_arrayCommands;
+		}
+		/**
+		 * @brief Get the byte offset of the non-indexed commands in the command buffer, which holds the indexed ones
+		 * first.
+		 */
+		[[nodiscard]] GLintptr getArrayCommandOffset() const noexcept
+		{
+			return static_cast<GLintptr>(m_elementCommands.size() * sizeof(DrawElementsIndirectCommand));
+		}
+		/**
+		 * @brief Get the buffer the commands are uploaded to.
+		 */
+		[[nodiscard]] const Buffer& getCommandBuffer() const noexcept { return m_commandBuffer; }
+		/**
+		 * @brief Get the buffer the per-draw data is uploaded to.
+		 */
+		[[nodiscard]] const Buffer& getPerDrawBuffer() const noexcept { return m_perDrawBuffer; }
+		/**
+		 * @brief Get the size in bytes of each draw's data.
+		 */
+		[[nodiscard]] std::size_t getPerDrawStride() const noexcept { return m_perDrawStride; }
+
+	private:
+		std::size_t m_perDrawStride;
+		std::vector<DrawElementsIndirectCommand> m_elementCommands;
+		std::vector<DrawArraysIndirectCommand> m_arrayCommands;
+		std::vector<std::byte> m_perDraw;
+		std::vector<std::byte> m_uploadBuffer;
+		GLuint m_slotCount = 0;
+
+		Buffer m_commandBuffer;
+		Buffer m_perDrawBuffer;
+
+		GLuint reserveSlots(const GLuint instanceCount)
+		{
+			// Draws of no instances still get a slot, so the baseInstance returned for them can be written to.
+			const GLuint baseInstance = m_slotCount;
+			m_slotCount += std::max(instanceCount, 1u);
+			m_perDraw.resize(static_cast<std::size_t>(m_slotCount) * m_perDrawStride);
+			return baseInstance;
+		}
+	};
+}
+
+#endif //GAL_DRAW_INDIRECT_BUFFER_HPP
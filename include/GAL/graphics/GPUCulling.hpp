@@ -0,0 +1,368 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_GPU_CULLING_HPP
+#define GAL_GPU_CULLING_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "Buffer.hpp"
+#include "DrawIndirectBuffer.hpp"
+#include "Program.hpp"
+#include "Shader.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief Bounding sphere of a draw, laid out as a vec4 (center in xyz, radius in w) in a shader storage buffer.
+	 */
+	struct BoundingSphere
+	{
+		glm::vec3 center;
+		float radius;
+	};
+
+	/**
+	 * @brief One level of a depth pyramid on the CPU, holding the farthest depth under each texel, as used by
+	 * cullDrawsReference() and built by buildDepthPyramidReference().
+	 */
+	struct DepthPyramidLevel
+	{
+		GLsizei width;
+		GLsizei height;
+		/// Window-space depths in [0, 1], row by row from the bottom, as OpenGL stores textures.
+		std::vector<float> depths;
+
+		[[nodiscard]] float at(const GLsizei x, const GLsizei y) const noexcept
+		{
+			return depths[static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x)];
+		}
+	};
+
+	/**
+	 * @brief Get the six planes bounding the view frustum of a view-projection matrix, in the order left, right,
+	 * bottom, top, near, far. Each plane's normal (xyz) points into the frustum and is normalized, so
+	 * dot(plane.xyz, point) + plane.w is the distance of a point inside it.
+	 * @param viewProjection The view-projection matrix, with OpenGL's [-1, 1] clip space depth.
+	 */
+	[[nodiscard]] inline std::array<glm::vec4, 6> extractFrustumPlanes(const glm::mat4& viewProjection) noexcept
+	{
+		const glm::mat4 rows = glm::transpose(viewProjection);
+		std::array<glm::vec4, 6> planes = {
+			rows[3] + rows[0], rows[3] - rows[0],
+			rows[3] + rows[1], rows[3] - rows[1],
+			rows[3] + rows[2], rows[3] - rows[2]};
+
+		for (glm::vec4& plane : planes)
+			plane /= glm::length(glm::vec3{plane});
+		return planes;
+	}
+
+	namespace detail
+	{
+		inline bool sphereInFrustum(const BoundingSphere& sphere, const std::array<glm::vec4, 6>& planes) noexcept
+		{
+			for (const glm::vec4& plane : planes)
+				if (glm::dot(glm::vec3{plane}, sphere.center) + plane.w < -sphere.radius)
+					return false;
+			return true;
+		}
+
+		/**
+		 * @brief CPU mirror of sphereOccluded() in CULLING_COMPUTE_GLSL.
+		 */
+		inline bool sphereOccluded(const BoundingSphere& sphere, const glm::mat4& viewProjection,
+			const std::vector<DepthPyramidLevel>& pyramid) noexcept
+		{
+			glm::vec2 minUV{1.0f};
+			glm::vec2 maxUV{0.0f};
+			float minDepth = 1.0f;
+
+			for (int i = 0; i < 8; ++i)
+			{
+				const glm::vec3 corner = sphere.center + sphere.radius * glm::vec3{
+					(i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f};
+				const glm::vec4 clip = viewProjection * glm::vec4{corner, 1.0f};
+				if (clip.w <= 0.0f)
+					return false;
+
+				const glm::vec3 ndc = glm::vec3{clip} / clip.w;
+				minUV = glm::min(minUV, glm::vec2{ndc} * 0.5f + 0.5f);
+				maxUV = glm::max(maxUV, glm::vec2{ndc} * 0.5f + 0.5f);
+				minDepth = std::min(minDepth, ndc.z * 0.5f + 0.5f);
+			}
+
+			minUV = glm::clamp(minUV, 0.0f, 1.0f);
+			maxUV = glm::clamp(maxUV, 0.0f, 1.0f);
+
+			const glm::vec2 extent = (maxUV - minUV) * glm::vec2(pyramid[0].width, pyramid[0].height);
+			const int level = std::clamp(static_cast<int>(std::ceil(std::log2(std::max({extent.x, extent.y, 1.0f})))),
+				0, static_cast<int>(pyramid.size()) - 1);
+
+			const DepthPyramidLevel& texels = pyramid[level];
+			const glm::ivec2 size{texels.width, texels.height};
+			const glm::ivec2 lo = glm::clamp(glm::ivec2{minUV * glm::vec2{size}}, glm::ivec2{0}, size - 1);
+			const glm::ivec2 hi = glm::clamp(glm::ivec2{maxUV * glm::vec2{size}}, glm::ivec2{0}, size - 1);
+			const float occluder = std::max({texels.at(lo.x, lo.y), texels.at(hi.x, lo.y), texels.at(lo.x, hi.y),
+				texels.at(hi.x, hi.y)});
+
+			return minDepth > occluder;
+		}
+	}
+
+	/**
+	 * @brief Compute shader run by CullingPass. Tests each draw's bounding sphere against the view frustum and,
+	 * optionally, a depth pyramid holding the farthest depth under each texel, and appends the commands of visible
+	 * draws to the output with an atomic counter.
+	 */
+	inline constexpr const char* CULLING_COMPUTE_GLSL =
+		"#version 460 core\n"
+		"layout(local_size_x = 64) in;\n"
+		"struct DrawCommand { uint count; uint instanceCount; uint firstIndex; int baseVertex; uint baseInstance; };\n"
+		"layout(std430, binding = 0) readonly buffer Bounds { vec4 bounds[]; };\n"
+		"layout(std430, binding = 1) readonly buffer InCommands { DrawCommand inCommands[]; };\n"
+		"layout(std430, binding = 2) writeonly buffer OutCommands { DrawCommand outCommands[]; };\n"
+		"layout(std430, binding = 3) buffer DrawCount { uint drawCount; };\n"
+		"uniform vec4 u_planes[6];\n"
+		"uniform mat4 u_viewProjection;\n"
+		"uniform uint u_drawCount;\n"
+		"uniform bool u_useHiZ;\n"
+		"uniform sampler2D u_hiZ;\n"
+		"bool sphereInFrustum(vec4 sphere)\n"
+		"{\n"
+		"\tfor (int i = 0; i < 6; ++i)\n"
+		"\t\tif (dot(u_planes[i].xyz, sphere.xyz) + u_planes[i].w < -sphere.w)\n"
+		"\t\t\treturn false;\n"
+		"\treturn true;\n"
+		"}\n"
+		"bool sphereOccluded(vec4 sphere)\n"
+		"{\n"
+		"\tvec2 minUV = vec2(1.0);\n"
+		"\tvec2 maxUV = vec2(0.0);\n"
+		"\tfloat minDepth = 1.0;\n"
+		"\tfor (int i = 0; i < 8; ++i)\n"
+		"\t{\n"
+		"\t\tvec3 corner = sphere.xyz + sphere.w * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0,\n"
+		"\t\t\t(i & 4) != 0 ? 1.0 : -1.0);\n"
+		"\t\tvec4 clip = u_viewProjection * vec4(corner, 1.0);\n"
+		"\t\tif (clip.w <= 0.0)\n"
+		"\t\t\treturn false;\n"
+		"\t\tvec3 ndc = clip.xyz / clip.w;\n"
+		"\t\tminUV = min(minUV, ndc.xy * 0.5 + 0.5);\n"
+		"\t\tmaxUV = max(maxUV, ndc.xy * 0.5 + 0.5);\n"
+		"\t\tminDepth = min(minDepth, ndc.z * 0.5 + 0.5);\n"
+		"\t}\n"
+		"\tminUV = clamp(minUV, 0.0, 1.0);\n"
+		"\tmaxUV = clamp(maxUV, 0.0, 1.0);\n"
+		"\tvec2 extent = (maxUV - minUV) * vec2(textureSize(u_hiZ, 0));\n"
+		"\tint level = clamp(int(ceil(log2(max(max(extent.x, extent.y), 1.0)))), 0, textureQueryLevels(u_hiZ) - 1);\n"
+		"\tivec2 size = textureSize(u_hiZ, level);\n"
+		"\tivec2 lo = clamp(ivec2(minUV * vec2(size)), ivec2(0), size - 1);\n"
+		"\tivec2 hi = clamp(ivec2(maxUV * vec2(size)), ivec2(0), size - 1);\n"
+		"\tfloat occluder = max(max(texelFetch(u_hiZ, lo, level).r, texelFetch(u_hiZ, ivec2(hi.x, lo.y), level).r),\n"
+		"\t\tmax(texelFetch(u_hiZ, ivec2(lo.x, hi.y), level).r, texelFetch(u_hiZ, hi, level).r));\n"
+		"\treturn minDepth > occluder;\n"
+		"}\n"
+		"void main()\n"
+		"{\n"
+		"\tuint i = gl_GlobalInvocationID.x;\n"
+		"\tif (i >= u_drawCount)\n"
+		"\t\treturn;\n"
+		"\tvec4 sphere = bounds[i];\n"
+		"\tif (!sphereInFrustum(sphere) || (u_useHiZ && sphereOccluded(sphere)))\n"
+		"\t\treturn;\n"
+		"\toutCommands[atomicAdd(drawCount, 1u)] = inCommands[i];\n"
+		"}\n";
+
+	/**
+	 * @brief Reference implementation of CullingPass on the CPU, for checking the GPU's results. The GPU appends
+	 * visible draws in no particular order, so compare the results as sets.
+	 * @param commands The draws' commands.
+	 * @param bounds The draws' bounding spheres, one per command.
+	 * @param viewProjection The view-projection matrix to cull against.
+	 * @param pyramid Depth pyramid to test occlusion against, from level 0 down, or nullptr to cull only against the
+	 * frustum.
+	 * @return Commands of the visible draws, in their original order.
+	 * @throws ErrCode::MissingCullingBounds If there are fewer bounding spheres than commands.
+	 */
+	[[nodiscard]] inline std::vector<DrawElementsIndirectCommand> cullDrawsReference(
+		const std::vector<DrawElementsIndirectCommand>& commands, const std::vector<BoundingSphere>& bounds,
+		const glm::mat4& viewProjection, const std::vector<DepthPyramidLevel>* pyramid = nullptr)
+	{
+		if (bounds.size() < commands.size())
+		{
+			detail::logErrStart() << "Attempted to cull " << commands.size() << " draws with only " << bounds.size() <<
+				" bounding spheres." << detail::logErrEnd;
+			detail::throwErr(ErrCode::MissingCullingBounds, "Attempted to cull draws without a bounding sphere each.");
+		}
+
+		const std::array<glm::vec4, 6> planes = extractFrustumPlanes(viewProjection);
+
+		std::vector<DrawElementsIndirectCommand> visible;
+		for (std::size_t i = 0; i < commands.size(); ++i)
+		{
+			if (!detail::sphereInFrustum(bounds[i], planes) ||
+				(pyramid && !pyramid->empty() && detail::sphereOccluded(bounds[i], viewProjection, *pyramid)))
+				continue;
+			visible.push_back(commands[i]);
+		}
+		return visible;
+	}
+
+	/**
+	 * @brief Culls a DrawIndirectBuffer's indexed draws on the GPU. A compute pass tests each draw's bounding sphere
+	 * against the view frustum and, optionally, a Hi-Z depth pyramid, and writes the commands of the visible draws
+	 * and their number to buffers that draw() submits with glMultiDrawElementsIndirectCount(), so the CPU never sees
+	 * which draws survived.
+	 *
+	 * Draws keep their baseInstance, so per-draw data is still found at perDraw[gl_BaseInstance + gl_InstanceID].
+	 *
+	 * @code
+	 * gal::CullingPass culling;
+	 * // Each frame, after draws.upload() and uploading one BoundingSphere per draw to bounds:
+	 * culling.cull(draws, bounds, projection * view, hiZ.getTexture());
+	 * program.use();
+	 * vertexArray.bind();
+	 * culling.draw(gal::DrawMode::Triangles, gal::IndexType::UnsignedInt);
+	 * @endcode
+	 */
+	class CullingPass
+	{
+	public:
+		/// Work group size of CULLING_COMPUTE_GLSL.
+		static constexpr GLuint GroupSize = 64;
+
+		/**
+		 * @brief Create the culling pass, compiling its compute shader.
+		 * @throws ErrCode::CreateBufferFailed If creating the output buffers fails.
+		 * @throws ErrCode::ShaderCompilationFailed If compiling the compute shader fails.
+		 * @throws ErrCode::ProgramLinkFailed If linking the compute program fails.
+		 */
+		CullingPass()
+		{
+			detail::logInfo("Creating culling pass...");
+			detail::logIncreaseIndent();
+
+			const Shader shader{ShaderType::Compute};
+			shader.sourceString(CULLING_COMPUTE_GLSL);
+			shader.compile();
+			m_program.attachShader(shader);
+			m_program.link();
+			m_program.setUniform("u_hiZ", 0);
+
+			m_drawCount.allocate(sizeof(GLuint), BufferUsage::DynamicCopy);
+
+			detail::logInfo("Successfully created culling pass.");
+			detail::logDecreaseIndent();
+		}
+
+		/**
+		 * @brief Cull the indexed draws of a DrawIndirectBuffer, writing the visible ones for draw(). Must be called
+		 * after the buffer's upload(). Ends with the barrier that makes the results visible to indirect draws.
+		 * @param draws The draws, already uploaded.
+		 * @param bounds Buffer of one BoundingSphere per indexed draw, in the same order.
+		 * @param viewProjection The view-projection matrix to cull against.
+		 * @param hiZ Texture whose mip levels hold the farthest window-space depth under each texel in red, e.g. a
+		 * HiZPyramid built from last frame's (or an early pass's) depth buffer with the default depth range, or 0 to
+		 * cull only against the frustum.
+		 */
+		void cull(const DrawIndirectBuffer& draws, const Buffer& bounds, const glm::mat4& viewProjection,
+			const TextureID hiZ = 0)
+		{
+			const auto count = static_cast<GLuint>(draws.getElementCommands().size());
+			if (count > m_capacity)
+			{
+				m_commands.allocate(static_cast<GLsizeiptr>(count * sizeof(DrawElementsIndirectCommand)),
+					BufferUsage::DynamicCopy);
+				m_capacity = count;
+			}
+			m_maxDrawCount = count;
+
+			glClearNamedBufferData(m_drawCount.getID(), GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+			if (count == 0)
+				return;
+
+			m_program.setUniformArray("u_planes", extractFrustumPlanes(viewProjection));
+			m_program.setUniform("u_viewProjection", viewProjection);
+			m_program.setUniform("u_drawCount", count);
+			m_program.setUniform("u_useHiZ", hiZ != 0);
+			if (hiZ)
+				detail::bindTextureUnit(0, hiZ);
+
+			bounds.bindIndexed(IndexedBufferTarget::ShaderStorage, 0);
+			draws.getCommandBuffer().bindIndexed(IndexedBufferTarget::ShaderStorage, 1);
+			m_commands.bindIndexed(IndexedBufferTarget::ShaderStorage, 2);
+			m_drawCount.bindIndexed(IndexedBufferTarget::ShaderStorage, 3);
+
+			m_program.dispatch((count + GroupSize - 1) / GroupSize);
+			glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+		}
+
+		/**
+		 * @brief Submit the draws that survived the last cull() with one glMultiDrawElementsIndirectCount() call, using
+		 * the program and vertex array currently bound.
+		 * @param mode Primitive type of every draw.
+		 * @param indexType Type of the indices in the element buffer.
+		 */
+		void draw(const DrawMode mode, const IndexType indexType) const noexcept
+		{
+			if (m_maxDrawCount == 0)
+				return;
+			DrawIndirectBuffer::drawElementsCount(mode, indexType, m_commands, m_drawCount, 0,
+				static_cast<GLsizei>(m_maxDrawCount));
+		}
+
+		/**
+		 * @brief Read back the number of draws that survived the last cull(). Waits for the GPU, so only use it for
+		 * debugging and tests.
+		 */
+		[[nodiscard]] GLuint readVisibleCount() const noexcept
+		{
+			// Make the compute pass's writes visible to glGetNamedBufferSubData().
+			glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+			GLuint count = 0;
+			glGetNamedBufferSubData(m_drawCount.getID(), 0, sizeof(count), &count);
+			return count;
+		}
+
+		/**
+		 * @brief Read back the commands of the draws that survived the last cull(), in the order the GPU wrote them.
+		 * Waits for the GPU, so only use it for debugging and tests.
+		 */
+		[[nodiscard]] std::vector<DrawElementsIndirectCommand> readVisibleCommands() const
+		{
+			// readVisibleCount() issues the GL_BUFFER_UPDATE_BARRIER_BIT barrier that this read needs too.
+			std::vector<DrawElementsIndirectCommand> commands(readVisibleCount());
+			if (!commands.empty())
+				glGetNamedBufferSubData(m_commands.getID(), 0,
+					static_cast<GLsizeiptr>(commands.size() * sizeof(DrawElementsIndirectCommand)), commands.data());
+			return commands;
+		}
+
+		/**
+		 * @brief Get the buffer the visible draws' commands are written to.
+		 */
+		[[nodiscard]] const Buffer& getCommandBuffer() const noexcept { return m_commands; }
+		/**
+		 * @brief Get the buffer the number of visible draws is written to, as a GLuint at offset 0.
+		 */
+		[[nodiscard]] const Buffer& getDrawCountBuffer() const noexcept { return m_drawCount; }
+		/**
+		 * @brief Get the compute program, e.g. to query it or cache its binary.
+		 */
+		[[nodiscard]] const Program& getProgram() const noexcept { return m_program; }
+
+	private:
+		Program m_program;
+		Buffer m_commands;
+		Buffer m_drawCount;
+		GLuint m_capacity = 0;
+		GLuint m_maxDrawCount = 0;
+	};
+}
+
+#endif //GAL_GPU_CULLING_HPP
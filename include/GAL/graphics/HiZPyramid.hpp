@@ -0,0 +1,576 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_HI_Z_PYRAMID_HPP
+#define GAL_HI_Z_PYRAMID_HPP
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Buffer.hpp"
+#include "GPUCulling.hpp"
+#include "Program.hpp"
+#include "Shader.hpp"
+
+namespace gal
+{
+	namespace detail
+	{
+		inline void hiZTextureDeleter(const TextureID id) noexcept
+		{
+			if (g_currentGLState)
+				g_currentGLState->forgetTexture(id);
+			glDeleteTextures(1, &id);
+		}
+
+		using UniqueHiZTexture = UniqueHandle<TextureID, 0, &hiZTextureDeleter>;
+
+		/**
+		 * @brief Get the largest power of two not greater than a size of at least 1.
+		 */
+		[[nodiscard]] constexpr GLsizei previousPowerOfTwo(const GLsizei size) noexcept
+		{
+			GLsizei power = 1;
+			while (power <= size / 2)
+				power *= 2;
+			return power;
+		}
+
+		/**
+		 * @brief Get the number of levels in a full mip chain of a texture.
+		 */
+		[[nodiscard]] constexpr GLsizei mipLevelCount(const GLsizei width, const GLsizei height) noexcept
+		{
+			GLsizei levels = 1;
+			for (GLsizei size = std::max(width, height); size > 1; size /= 2)
+				++levels;
+			return levels;
+		}
+
+		/**
+		 * @brief CPU mirror of loadSource() in HI_Z_COMMON_GLSL: reduce every source texel under each target texel.
+		 */
+		inline std::vector<float> reduceDepthLevel(const std::vector<float>& source, const GLsizei sourceWidth,
+			const GLsizei sourceHeight, const GLsizei width, const GLsizei height, const bool farthest)
+		{
+			std::vector<float> depths(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+			for (GLsizei y = 0; y < height; ++y)
+			{
+				const GLsizei y0 = y * sourceHeight / height;
+				const GLsizei y1 = ((y + 1) * sourceHeight + height - 1) / height;
+				for (GLsizei x = 0; x < width; ++x)
+				{
+					const GLsizei x0 = x * sourceWidth / width;
+					const GLsizei x1 = ((x + 1) * sourceWidth + width - 1) / width;
+
+					float depth = farthest ? 0.0f : 1.0f;
+					for (GLsizei sy = y0; sy < y1; ++sy)
+						for (GLsizei sx = x0; sx < x1; ++sx)
+						{
+							const float texel = source[static_cast<std::size_t>(sy) *
+								static_cast<std::size_t>(sourceWidth) + static_cast<std::size_t>(sx)];
+							depth = farthest ? std::max(depth, texel) : std::min(depth, texel);
+						}
+					depths[static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x)] =
+						depth;
+				}
+			}
+			return depths;
+		}
+	}
+
+	/**
+	 * @brief GLSL shared by HI_Z_SPD_COMPUTE_GLSL and HI_Z_LEVEL_COMPUTE_GLSL. Pyramid texels hold the farthest depth
+	 * under them in red and the nearest in green. Level 0 is the largest power of two that fits in the depth
+	 * texture, and each of its texels covers every depth texel it overlaps, so the pyramid stays conservative for any
+	 * depth texture size.
+	 */
+	inline constexpr const char* HI_Z_COMMON_GLSL =
+		"uniform sampler2D u_source;\n"
+		"uniform int u_sourceLevel;\n"
+		"uniform bool u_sourceIsDepth;\n"
+		"uniform ivec2 u_baseSize;\n"
+		"const vec2 EMPTY = vec2(0.0, 1.0);\n"
+		"ivec2 levelSize(int level)\n"
+		"{\n"
+		"\treturn max(u_baseSize >> level, ivec2(1));\n"
+		"}\n"
+		"vec2 reduce(vec2 a, vec2 b)\n"
+		"{\n"
+		"\treturn vec2(max(a.x, b.x), min(a.y, b.y));\n"
+		"}\n"
+		"vec2 loadSource(ivec2 p, ivec2 size)\n"
+		"{\n"
+		"\tivec2 sourceSize = textureSize(u_source, u_sourceLevel);\n"
+		"\tivec2 lo = p * sourceSize / size;\n"
+		"\tivec2 hi = ((p + 1) * sourceSize + size - 1) / size;\n"
+		"\tvec2 value = EMPTY;\n"
+		"\tfor (int y = lo.y; y < hi.y; ++y)\n"
+		"\t\tfor (int x = lo.x; x < hi.x; ++x)\n"
+		"\t\t{\n"
+		"\t\t\tvec4 texel = texelFetch(u_source, ivec2(x, y), u_sourceLevel);\n"
+		"\t\t\tvalue = reduce(value, u_sourceIsDepth ? texel.rr : texel.rg);\n"
+		"\t\t}\n"
+		"\treturn value;\n"
+		"}\n";
+
+	/**
+	 * @brief Single-pass downsampling compute shader run by HiZPyramid::build(). Each 16x16 work group reduces a 64x64
+	 * tile of the first level it writes down through the next 6 levels, 3 in registers and 3 in shared memory. The
+	 * last group to finish, found with an atomic counter, then reduces the groups' results down through the remaining
+	 * levels. GAL_HI_Z_IMAGES, the number of levels one dispatch can write, is defined when it's compiled.
+	 */
+	inline constexpr const char* HI_Z_SPD_COMPUTE_GLSL =
+		"layout(local_size_x = 16, local_size_y = 16) in;\n"
+		"layout(rg32f, binding = 0) uniform coherent image2D u_levels[GAL_HI_Z_IMAGES];\n"
+		"layout(std430, binding = 0) coherent buffer GroupCounter { uint groupsDone; };\n"
+		"uniform int u_firstLevel;\n"
+		"uniform int u_levelEnd;\n"
+		"uniform uint u_groupCount;\n"
+		"shared vec2 s_tile[16][16];\n"
+		"shared bool s_isLastGroup;\n"
+		"void storeLevel(int level, ivec2 p, vec2 value)\n"
+		"{\n"
+		"\tif (level < u_levelEnd && all(lessThan(p, levelSize(level))))\n"
+		"\t\timageStore(u_levels[level - u_firstLevel], p, vec4(value, 0.0, 0.0));\n"
+		"}\n"
+		"void main()\n"
+		"{\n"
+		"\tivec2 group = ivec2(gl_WorkGroupID.xy);\n"
+		"\tivec2 local = ivec2(gl_LocalInvocationID.xy);\n"
+		"\tivec2 origin = group * 64 + local * 4;\n"
+		"\tivec2 size = levelSize(u_firstLevel);\n"
+		"\tvec2 texels[4][4];\n"
+		"\tfor (int y = 0; y < 4; ++y)\n"
+		"\t\tfor (int x = 0; x < 4; ++x)\n"
+		"\t\t{\n"
+		"\t\t\tivec2 p = origin + ivec2(x, y);\n"
+		"\t\t\ttexels[y][x] = all(lessThan(p, size)) ? loadSource(p, size) : EMPTY;\n"
+		"\t\t\tstoreLevel(u_firstLevel, p, texels[y][x]);\n"
+		"\t\t}\n"
+		"\tvec2 quads[2][2];\n"
+		"\tfor (int y = 0; y < 2; ++y)\n"
+		"\t\tfor (int x = 0; x < 2; ++x)\n"
+		"\t\t{\n"
+		"\t\t\tquads[y][x] = reduce(reduce(texels[2 * y][2 * x], texels[2 * y][2 * x + 1]),\n"
+		"\t\t\t\treduce(texels[2 * y + 1][2 * x], texels[2 * y + 1][2 * x + 1]));\n"
+		"\t\t\tstoreLevel(u_firstLevel + 1, origin / 2 + ivec2(x, y), quads[y][x]);\n"
+		"\t\t}\n"
+		"\tvec2 value = reduce(reduce(quads[0][0], quads[0][1]), reduce(quads[1][0], quads[1][1]));\n"
+		"\tstoreLevel(u_firstLevel + 2, origin / 4, value);\n"
+		"\ts_tile[local.y][local.x] = value;\n"
+		"\tfor (int level = 3, tile = 8; level <= 6; ++level, tile /= 2)\n"
+		"\t{\n"
+		"\t\tbarrier();\n"
+		"\t\tbool active = all(lessThan(local, ivec2(tile)));\n"
+		"\t\tif (active)\n"
+		"\t\t{\n"
+		"\t\t\tivec2 c = local * 2;\n"
+		"\t\t\tvalue = reduce(reduce(s_tile[c.y][c.x], s_tile[c.y][c.x + 1]),\n"
+		"\t\t\t\treduce(s_tile[c.y + 1][c.x], s_tile[c.y + 1][c.x + 1]));\n"
+		"\t\t}\n"
+		"\t\tbarrier();\n"
+		"\t\tif (active)\n"
+		"\t\t{\n"
+		"\t\t\ts_tile[local.y][local.x] = value;\n"
+		"\t\t\tstoreLevel(u_firstLevel + level, group * tile + local, value);\n"
+		"\t\t}\n"
+		"\t}\n"
+		"\tif (u_levelEnd <= u_firstLevel + 7)\n"
+		"\t\treturn;\n"
+		"\tmemoryBarrierImage();\n"
+		"\tbarrier();\n"
+		"\tif (gl_LocalInvocationIndex == 0u)\n"
+		"\t\ts_isLastGroup = atomicAdd(groupsDone, 1u) == u_groupCount - 1u;\n"
+		"\tbarrier();\n"
+		"\tif (!s_isLastGroup)\n"
+		"\t\treturn;\n"
+		"\tfor (int level = u_firstLevel + 7; level < u_levelEnd; ++level)\n"
+		"\t{\n"
+		"\t\tivec2 levelExtent = levelSize(level);\n"
+		"\t\tivec2 previousExtent = levelSize(level - 1);\n"
+		"\t\tfor (int i = int(gl_LocalInvocationIndex); i < levelExtent.x * levelExtent.y; i += 256)\n"
+		"\t\t{\n"
+		"\t\t\tivec2 p = ivec2(i % levelExtent.x, i / levelExtent.x);\n"
+		"\t\t\tvalue = EMPTY;\n"
+		"\t\t\tfor (int y = 0; y < 2; ++y)\n"
+		"\t\t\t\tfor (int x = 0; x < 2; ++x)\n"
+		"\t\t\t\t{\n"
+		"\t\t\t\t\tivec2 c = p * 2 + ivec2(x, y);\n"
+		"\t\t\t\t\tif (all(lessThan(c, previousExtent)))\n"
+		"\t\t\t\t\t\tvalue = reduce(value, imageLoad(u_levels[level - 1 - u_firstLevel], c).rg);\n"
+		"\t\t\t\t}\n"
+		"\t\t\timageStore(u_levels[level - u_firstLevel], p, vec4(value, 0.0, 0.0));\n"
+		"\t\t}\n"
+		"\t\tmemoryBarrierImage();\n"
+		"\t\tbarrier();\n"
+		"\t}\n"
+		"\tif (gl_LocalInvocationIndex == 0u)\n"
+		"\t\tgroupsDone = 0u;\n"
+		"}\n";
+
+	/**
+	 * @brief Compute shader run by HiZPyramid::buildPerLevel(), which writes one level per dispatch from the level
+	 * above it, the way a pyramid is built without single-pass downsampling.
+	 */
+	inline constexpr const char* HI_Z_LEVEL_COMPUTE_GLSL =
+		"layout(local_size_x = 8, local_size_y = 8) in;\n"
+		"layout(rg32f, binding = 0) uniform writeonly image2D u_target;\n"
+		"uniform int u_targetLevel;\n"
+		"void main()\n"
+		"{\n"
+		"\tivec2 p = ivec2(gl_GlobalInvocationID.xy);\n"
+		"\tivec2 size = levelSize(u_targetLevel);\n"
+		"\tif (any(greaterThanEqual(p, size)))\n"
+		"\t\treturn;\n"
+		"\timageStore(u_target, p, vec4(loadSource(p, size), 0.0, 0.0));\n"
+		"}\n";
+
+	/**
+	 * @brief Build a depth pyramid on the CPU the way HiZPyramid does on the GPU, for checking its results or feeding
+	 * cullDrawsReference().
+	 * @param depth Window-space depths in [0, 1], row by row from the bottom, e.g. from glReadPixels().
+	 * @param width Width of the depth buffer.
+	 * @param height Height of the depth buffer.
+	 * @param farthest Whether to keep the farthest depth under each texel, as occlusion culling needs, or the nearest,
+	 * as screen-space ray marching needs.
+	 * @return Every level of the pyramid, from level 0 down to 1x1.
+	 */
+	[[nodiscard]] inline std::vector<DepthPyramidLevel> buildDepthPyramidReference(const float* depth,
+		const GLsizei width, const GLsizei height, const bool farthest = true)
+	{
+		std::vector<DepthPyramidLevel> pyramid;
+		if (width <= 0 || height <= 0)
+			return pyramid;
+
+		const GLsizei baseWidth = detail::previousPowerOfTwo(width);
+		const GLsizei baseHeight = detail::previousPowerOfTwo(height);
+		const GLsizei levels = detail::mipLevelCount(baseWidth, baseHeight);
+		pyramid.reserve(static_cast<std::size_t>(levels));
+
+		const std::vector<float> source(depth, depth + static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+		pyramid.push_back({baseWidth, baseHeight,
+			detail::reduceDepthLevel(source, width, height, baseWidth, baseHeight, farthest)});
+
+		for (GLsizei level = 1; level < levels; ++level)
+		{
+			const DepthPyramidLevel& previous = pyramid.back();
+			const GLsizei levelWidth = std::max(baseWidth >> level, 1);
+			const GLsizei levelHeight = std::max(baseHeight >> level, 1);
+			std::vector<float> depths = detail::reduceDepthLevel(previous.depths, previous.width, previous.height,
+				levelWidth, levelHeight, farthest);
+			pyramid.push_back({levelWidth, levelHeight, std::move(depths)});
+		}
+		return pyramid;
+	}
+
+	/**
+	 * @brief Average GPU time of building a pyramid with single-pass downsampling and with one dispatch per level,
+	 * measured by HiZPyramid::benchmark().
+	 */
+	struct HiZBenchmark
+	{
+		double singlePassMilliseconds = 0.0;
+		double perLevelMilliseconds = 0.0;
+		std::size_t singlePassDispatches = 0;
+		std::size_t perLevelDispatches = 0;
+	};
+
+	/**
+	 * @brief Hierarchical-Z depth pyramid built from a depth texture on the GPU. Each texel of its RG32F texture
+	 * holds the farthest (red) and nearest (green) depth under it, for occlusion culling and screen-space ray marching
+	 * respectively.
+	 *
+	 * build() writes the whole mip chain with single-pass downsampling: one dispatch, in which the last work group to
+	 * finish (found with an atomic counter) reduces the others' results down to 1x1. A dispatch can only write as
+	 * many levels as there are image units, so on implementations with fewer than the pyramid has levels (8 units
+	 * cover a 128x128 pyramid), build() issues as few extra dispatches as it takes.
+	 *
+	 * @code
+	 * gal::HiZPyramid hiZ;
+	 * // Each frame, after the depth pre-pass:
+	 * hiZ.build(depthTexture, width, height);
+	 * culling.cull(draws, bounds, projection * view, hiZ.getTexture());
+	 * @endcode
+	 */
+	class HiZPyramid : detail::UniqueHiZTexture
+	{
+	public:
+		/// Most levels a pyramid can have, enough for a 32768x32768 depth texture.
+		static constexpr GLsizei MaxLevels = 16;
+
+		/**
+		 * @brief Create the pyramid builder, compiling its compute shaders. The pyramid's texture is created by the
+		 * first build().
+		 * @throws ErrCode::CreateBufferFailed If creating the group counter buffer fails.
+		 * @throws ErrCode::ShaderCompilationFailed If compiling a compute shader fails.
+		 * @throws ErrCode::ProgramLinkFailed If linking a compute program fails.
+		 */
+		HiZPyramid()
+		{
+			detail::logInfo("Creating Hi-Z pyramid...");
+			detail::logIncreaseIndent();
+
+			GLint computeImages = 0;
+			GLint imageUnits = 0;
+			glGetIntegerv(GL_MAX_COMPUTE_IMAGE_UNIFORMS, &computeImages);
+			glGetIntegerv(GL_MAX_IMAGE_UNITS, &imageUnits);
+			// OpenGL 4.6 guarantees at least 8 of each, more than the 7 levels a work group writes before the last one.
+			m_imagesPerDispatch = std::clamp(std::min(computeImages, imageUnits), 8, MaxLevels);
+			detail::logInfoStart() << "Writing up to " << m_imagesPerDispatch << " levels per dispatch." <<
+				detail::logInfoEnd;
+
+			const std::string common = std::string{"#version 460 core\n"} + HI_Z_COMMON_GLSL;
+			compileProgram(m_singlePass, detail::insertAfterVersionDirective(common + HI_Z_SPD_COMPUTE_GLSL,
+				"#define GAL_HI_Z_IMAGES " + std::to_string(m_imagesPerDispatch) + "\n"));
+			compileProgram(m_perLevel, common + HI_Z_LEVEL_COMPUTE_GLSL);
+
+			m_groupCounter.allocate(sizeof(GLuint), BufferUsage::DynamicCopy);
+			glClearNamedBufferData(m_groupCounter.getID(), GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+			detail::logInfo("Successfully created Hi-Z pyramid.");
+			detail::logDecreaseIndent();
+		}
+
+		/**
+		 * @brief Build the pyramid from a depth texture with single-pass downsampling, (re)creating its texture first
+		 * if the depth texture's size changed. Ends with the barrier that makes the pyramid visible to texture fetches
+		 * and image loads.
+		 * @param depth The depth texture, with compare mode off. Only its level 0 is read.
+		 * @param width Width of the depth texture.
+		 * @param height Height of the depth texture.
+		 * @throws ErrCode::CreateTextureFailed If (re)creating the pyramid's texture fails.
+		 */
+		void build(const TextureID depth, const GLsizei width, const GLsizei height)
+		{
+			if (!resize(width, height))
+				return;
+
+			m_singlePass.setUniform("u_baseSize", glm::ivec2(m_width, m_height));
+			m_groupCounter.bindIndexed(IndexedBufferTarget::ShaderStorage, 0);
+			m_dispatchCount = 0;
+
+			for (GLsizei first = 0; first < m_levels; first += m_imagesPerDispatch)
+			{
+				const GLsizei end = std::min(first + m_imagesPerDispatch, m_levels);
+				bindSource(m_singlePass, depth, first);
+				for (GLsizei level = first; level < end; ++level)
+					glBindImageTexture(static_cast<GLuint>(level - first), getHandle(), level, GL_FALSE, 0,
+						GL_READ_WRITE, GL_RG32F);
+
+				const GLuint groupsX = static_cast<GLuint>(std::max(m_width >> first, 1) + 63) / 64;
+				const GLuint groupsY = static_cast<GLuint>(std::max(m_height >> first, 1) + 63) / 64;
+				m_singlePass.setUniform("u_firstLevel", first);
+				m_singlePass.setUniform("u_levelEnd", end);
+				m_singlePass.setUniform("u_groupCount", groupsX * groupsY);
+				m_singlePass.dispatch(groupsX, groupsY);
+				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+				++m_dispatchCount;
+			}
+		}
+
+		/**
+		 * @brief Build the same pyramid as build() with one dispatch per level and a barrier between each, for
+		 * comparison.
+		 * @throws ErrCode::CreateTextureFailed If (re)creating the pyramid's texture fails.
+		 */
+		void buildPerLevel(const TextureID depth, const GLsizei width, const GLsizei height)
+		{
+			if (!resize(width, height))
+				return;
+
+			m_perLevel.setUniform("u_baseSize", glm::ivec2(m_width, m_height));
+			m_dispatchCount = 0;
+
+			for (GLsizei level = 0; level < m_levels; ++level)
+			{
+				bindSource(m_perLevel, depth, level);
+				glBindImageTexture(0, getHandle(), level, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG32F);
+
+				m_perLevel.setUniform("u_targetLevel", level);
+				m_perLevel.dispatch(static_cast<GLuint>(std::max(m_width >> level, 1) + 7) / 8,
+					static_cast<GLuint>(std::max(m_height >> level, 1) + 7) / 8);
+				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+				++m_dispatchCount;
+			}
+		}
+
+		/**
+		 * @brief Time build() against buildPerLevel() on the GPU with timer queries. Waits for the GPU, so only use it
+		 * for profiling.
+		 * @param depth The depth texture.
+		 * @param width Width of the depth texture.
+		 * @param height Height of the depth texture.
+		 * @param iterations Number of builds each way to average over, after one warm-up build each.
+		 * @throws ErrCode::CreateTextureFailed If (re)creating the pyramid's texture fails.
+		 */
+		[[nodiscard]] HiZBenchmark benchmark(const TextureID depth, const GLsizei width, const GLsizei height,
+			const int iterations = 100)
+		{
+			HiZBenchmark result;
+			if (iterations <= 0)
+				return result;
+
+			GLuint query = 0;
+			glCreateQueries(GL_TIME_ELAPSED, 1, &query);
+
+			const auto time = [&](void (HiZPyramid::*build)(TextureID, GLsizei, GLsizei)) {
+				(this->*build)(depth, width, height);
+				glBeginQuery(GL_TIME_ELAPSED, query);
+				for (int i = 0; i < iterations; ++i)
+					(this->*build)(depth, width, height);
+				glEndQuery(GL_TIME_ELAPSED);
+
+				GLuint64 nanoseconds = 0;
+				glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+				return static_cast<double>(nanoseconds) / 1e6 / iterations;
+			};
+
+			result.perLevelMilliseconds = time(&HiZPyramid::buildPerLevel);
+			result.perLevelDispatches = m_dispatchCount;
+			result.singlePassMilliseconds = time(&HiZPyramid::build);
+			result.singlePassDispatches = m_dispatchCount;
+
+			glDeleteQueries(1, &query);
+
+			detail::logInfoStart() << "Hi-Z pyramid " << m_width << "x" << m_height << ": single-pass " <<
+				result.singlePassMilliseconds << " ms in " << result.singlePassDispatches << " dispatch(es), per-level " <<
+				result.perLevelMilliseconds << " ms in " << result.perLevelDispatches << " dispatches." <<
+				detail::logInfoEnd;
+			return result;
+		}
+
+		/**
+		 * @brief Read back one level of the pyramid. Waits for the GPU, so only use it for debugging and tests.
+		 * @param level The level, from 0 to getLevelCount() - 1.
+		 * @param farthest Whether to read the farthest depths (red) or the nearest (green).
+		 */
+		[[nodiscard]] DepthPyramidLevel readLevel(const GLsizei level, const bool farthest = true) const
+		{
+			DepthPyramidLevel result{std::max(m_width >> level, 1), std::max(m_height >> level, 1), {}};
+			const std::size_t texels = static_cast<std::size_t>(result.width) * static_cast<std::size_t>(result.height);
+
+			std::vector<float> rg(texels * 2);
+			glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+			glGetTextureImage(getHandle(), level, GL_RG, GL_FLOAT, static_cast<GLsizei>(rg.size() * sizeof(float)),
+				rg.data());
+
+			result.depths.resize(texels);
+			for (std::size_t i = 0; i < texels; ++i)
+				result.depths[i] = rg[i * 2 + (farthest ? 0 : 1)];
+			return result;
+		}
+
+		/**
+		 * @brief Read back every level of the pyramid, e.g. to compare with buildDepthPyramidReference(). Waits for the
+		 * GPU, so only use it for debugging and tests.
+		 */
+		[[nodiscard]] std::vector<DepthPyramidLevel> readLevels(const bool farthest = true) const
+		{
+			std::vector<DepthPyramidLevel> levels;
+			levels.reserve(static_cast<std::size_t>(m_levels));
+			for (GLsizei level = 0; level < m_levels; ++level)
+				levels.push_back(readLevel(level, farthest));
+			return levels;
+		}
+
+		/**
+		 * @brief Get the pyramid's texture, or 0 before the first build.
+		 */
+		[[nodiscard]] TextureID getTexture() const noexcept { return getHandle(); }
+		/**
+		 * @brief Get the width of level 0, the largest power of two not greater than the depth texture's width.
+		 */
+		[[nodiscard]] GLsizei getWidth() const noexcept { return m_width; }
+		/**
+		 * @brief Get the height of level 0, the largest power of two not greater than the depth texture's height.
+		 */
+		[[nodiscard]] GLsizei getHeight() const noexcept { return m_height; }
+		/**
+		 * @brief Get the number of levels in the pyramid.
+		 */
+		[[nodiscard]] GLsizei getLevelCount() const noexcept { return m_levels; }
+		/**
+		 * @brief Get the number of levels one single-pass dispatch can write, limited by the image units available.
+		 */
+		[[nodiscard]] GLsizei getLevelsPerDispatch() const noexcept { return m_imagesPerDispatch; }
+		/**
+		 * @brief Get the number of dispatches the last build issued.
+		 */
+		[[nodiscard]] std::size_t getDispatchCount() const noexcept { return m_dispatchCount; }
+
+	private:
+		Program m_singlePass;
+		Program m_perLevel;
+		Buffer m_groupCounter;
+		GLsizei m_imagesPerDispatch = 8;
+		GLsizei m_depthWidth = 0;
+		GLsizei m_depthHeight = 0;
+		GLsizei m_width = 0;
+		GLsizei m_height = 0;
+		GLsizei m_levels = 0;
+		std::size_t m_dispatchCount = 0;
+
+		static void compileProgram(Program& program, const std::string& source)
+		{
+			const Shader shader{ShaderType::Compute};
+			shader.sourceString(source);
+			shader.compile();
+			program.attachShader(shader);
+			program.link();
+			program.setUniform("u_source", 0);
+		}
+
+		/**
+		 * @brief Recreate the texture if the depth texture's size changed.
+		 * @return Whether there is a pyramid to build, i.e., the size isn't empty.
+		 */
+		bool resize(const GLsizei width, const GLsizei height)
+		{
+			if (width <= 0 || height <= 0)
+				return false;
+			if (width == m_depthWidth && height == m_depthHeight && handleValid())
+				return true;
+
+			const GLsizei baseWidth = detail::previousPowerOfTwo(width);
+			const GLsizei baseHeight = detail::previousPowerOfTwo(height);
+			const GLsizei levels = detail::mipLevelCount(baseWidth, baseHeight);
+
+			TextureID id;
+			glCreateTextures(GL_TEXTURE_2D, 1, &id);
+			if (!id)
+				detail::throwErr(ErrCode::CreateTextureFailed, "Failed to create Hi-Z pyramid texture.");
+			glTextureStorage2D(id, levels, GL_RG32F, baseWidth, baseHeight);
+			glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+			glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			detail::logInfoStart() << "Created " << baseWidth << "x" << baseHeight << " Hi-Z pyramid texture ID " << id <<
+				" with " << levels << " levels." << detail::logInfoEnd;
+
+			setHandle(id);
+			m_depthWidth = width;
+			m_depthHeight = height;
+			m_width = baseWidth;
+			m_height = baseHeight;
+			m_levels = levels;
+			return true;
+		}
+
+		/**
+		 * @brief Bind what the first level a dispatch writes is reduced from: the depth texture for level 0, otherwise
+		 * the pyramid's level above it.
+		 */
+		void bindSource(const Program& program, const TextureID depth, const GLsizei level) const
+		{
+			detail::bindTextureUnit(0, level == 0 ? depth : getHandle());
+			program.setUniform("u_sourceLevel", level == 0 ? 0 : level - 1);
+			program.setUniform("u_sourceIsDepth", level == 0);
+		}
+	};
+}
+
+#endif //GAL_HI_Z_PYRAMID_HPP
@@ -0,0 +1,281 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_INDEX_BUFFER_HPP
+#define GAL_INDEX_BUFFER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "Buffer.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief Get the size of an index of the given type in bytes.
+	 */
+	[[nodiscard]] inline GLsizei indexTypeSize(const IndexType type) noexcept
+	{
+		return type == IndexType::UnsignedShort ? 2 : 4;
+	}
+
+	/**
+	 * @brief Get the index value GL_PRIMITIVE_RESTART_FIXED_INDEX uses for the given index type.
+	 */
+	[[nodiscard]] inline GLuint primitiveRestartIndex(const IndexType type) noexcept
+	{
+		return type == IndexType::UnsignedShort ? 0xFFFFu : 0xFFFFFFFFu;
+	}
+
+	/**
+	 * @brief Convert a triangle list into triangle strips separated by a primitive restart index. Triangle winding is
+	 * preserved and degenerate triangles are dropped.
+	 * @param triangles Triangle list indices.
+	 * @param restartIndex The index to separate strips with.
+	 * @return Strip indices.
+	 */
+	[[nodiscard]] inline std::vector<GLuint> stripifyTriangles(const std::vector<GLuint>& triangles,
+		const GLuint restartIndex)
+	{
+		const auto triangleCount = static_cast<GLuint>(triangles.size() / 3);
+
+		// Every directed edge of every triangle, sorted so the triangle on the other side of an edge can be found
+		// with a binary search.
+		struct Edge
+		{
+			std::uint64_t key;
+			GLuint triangle;
+			GLuint opposite;
+
+			bool operator<(const Edge& other) const noexcept { return key < other.key; }
+		};
+
+		const auto edgeKey = [](const GLuint from, const GLuint to)
+		{
+			return static_cast<std::uint64_t>(from) << 32 | to;
+		};
+
+		std::vector<bool> used(triangleCount, false);
+		std::vector<Edge> edges;
+		edges.reserve(triangles.size());
+
+		for (GLuint t = 0; t < triangleCount; ++t)
+		{
+			const GLuint a = triangles[t * 3];
+			const GLuint b = triangles[t * 3 + 1];
+			const GLuint c = triangles[t * 3 + 2];
+
+			if (a == b || b == c || c == a)
+			{
+				used[t] = true;
+				continue;
+			}
+
+			edges.push_back({edgeKey(a, b), t, c});
+			edges.push_back({edgeKey(b, c), t, a});
+			edges.push_back({edgeKey(c, a), t, b});
+		}
+
+		std::sort(edges.begin(), edges.end());
+
+		// Find an unused triangle containing the directed edge from -> to and return its third vertex.
+		const auto findNeighbor = [&](const GLuint from, const GLuint to, GLuint& triangle, GLuint& opposite)
+		{
+			const Edge key{edgeKey(from, to), 0, 0};
+			for (auto [it, end] = std::equal_range(edges.begin(), edges.end(), key); it != end; ++it)
+				if (!used[it->triangle])
+				{
+					triangle = it->triangle;
+					opposite = it->opposite;
+					return true;
+				}
+
+			return false;
+		};
+
+		std::vector<GLuint> result;
+		std::vector<GLuint> strip;
+		result.reserve(triangles.size());
+
+		for (GLuint start = 0; start < triangleCount; ++start)
+		{
+			if (used[start])
+				continue;
+
+			used[start] = true;
+
+			// Start with whichever rotation of the triangle can be continued, if any.
+			GLuint a = triangles[start * 3];
+			GLuint b = triangles[start * 3 + 1];
+			GLuint c = triangles[start * 3 + 2];
+			for (int rotation = 0; rotation < 3; ++rotation)
+			{
+				GLuint triangle, opposite;
+				if (findNeighbor(c, b, triangle, opposite))
+					break;
+
+				std::tie(a, b, c) = std::make_tuple(b, c, a);
+			}
+
+			strip.assign({a, b, c});
+
+			// Triangle k of a strip is (s[k], s[k+1], s[k+2]) when k is even and (s[k+1], s[k], s[k+2]) when k is
+			// odd, so the next triangle must contain the matching directed edge.
+			while (true)
+			{
+				const std::size_t k = strip.size() - 2;
+				const GLuint from = k % 2 == 0 ? strip[k] : strip[k + 1];
+				const GLuint to = k % 2 == 0 ? strip[k + 1] : strip[k];
+
+				GLuint triangle, opposite;
+				if (!findNeighbor(from, to, triangle, opposite))
+					break;
+
+				used[triangle] = true;
+				strip.push_back(opposite);
+			}
+
+			if (!result.empty())
+				result.push_back(restartIndex);
+			result.insert(result.end(), strip.begin(), strip.end());
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Index data ready to be uploaded, in the smallest index type that fits.
+	 */
+	struct CompactIndices
+	{
+		std::vector<std::byte> data;
+		IndexType type = IndexType::UnsignedInt;
+		DrawMode mode = DrawMode::Triangles;
+		GLsizei count = 0;
+		/// Whether the indices are restart-separated strips that need GL_PRIMITIVE_RESTART_FIXED_INDEX.
+		bool primitiveRestart = false;
+	};
+
+	/**
+	 * @brief Choose the smallest index type for a triangle list and, optionally, convert it to restart-separated
+	 * triangle strips if that makes it smaller.
+	 * @param triangles Triangle list indices.
+	 * @param allowStrips Whether converting to triangle strips is allowed.
+	 * @return The compacted indices.
+	 */
+	[[nodiscard]] inline CompactIndices compactIndices(const std::vector<GLuint>& triangles,
+		const bool allowStrips = false)
+	{
+		const GLuint maxIndex = triangles.empty() ? 0 : *std::max_element(triangles.begin(), triangles.end());
+
+		CompactIndices result;
+		result.type = maxIndex <= 0xFFFFu ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+		const std::vector<GLuint>* indices = &triangles;
+		std::vector<GLuint> strips;
+
+		if (allowStrips)
+		{
+			// The restart index can't also be a vertex index, so strips may need a larger type than the list.
+			const IndexType stripType = maxIndex < 0xFFFFu ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+			strips = stripifyTriangles(triangles, primitiveRestartIndex(stripType));
+
+			if (strips.size() * indexTypeSize(stripType) < triangles.size() * indexTypeSize(result.type))
+			{
+				indices = &strips;
+				result.type = stripType;
+				result.mode = DrawMode::TriangleStrip;
+				result.primitiveRestart = true;
+			}
+		}
+
+		result.count = static_cast<GLsizei>(indices->size());
+		result.data.resize(indices->size() * indexTypeSize(result.type));
+
+		if (result.type == IndexType::UnsignedShort)
+		{
+			auto* dst = reinterpret_cast<std::uint16_t*>(result.data.data());
+			for (std::size_t i = 0; i < indices->size(); ++i)
+				dst[i] = static_cast<std::uint16_t>((*indices)[i]);
+		}
+		else
+			std::copy(indices->begin(), indices->end(), reinterpret_cast<GLuint*>(result.data.data()));
+
+		return result;
+	}
+
+	/**
+	 * @brief An element buffer that remembers the index type, primitive type and index count it was built with, so
+	 * they never have to be hard-coded where it's drawn.
+	 */
+	class IndexBuffer
+	{
+	public:
+		/**
+		 * @brief Build an index buffer from a triangle list, using 16-bit indices when they fit and, if allowed,
+		 * restart-separated triangle strips when they're smaller.
+		 * @param triangles Triangle list indices.
+		 * @param allowStrips Whether converting to triangle strips is allowed.
+		 * @param usage Buffer usage hint.
+		 * @throws ErrCode::CreateBufferFailed If creating the buffer fails.
+		 */
+		explicit IndexBuffer(const std::vector<GLuint>& triangles, const bool allowStrips = false,
+			const BufferUsage usage = BufferUsage::StaticDraw)
+		{
+			const CompactIndices indices = compactIndices(triangles, allowStrips);
+			m_buffer.allocateAndWrite(indices.data, usage);
+			m_type = indices.type;
+			m_mode = indices.mode;
+			m_count = indices.count;
+			m_primitiveRestart = indices.primitiveRestart;
+
+			detail::logInfoStart() << "Built index buffer ID " << m_buffer.getID() << " with " << m_count <<
+				(m_type == IndexType::UnsignedShort ? " 16-bit" : " 32-bit") << " indices" <<
+				(m_primitiveRestart ? " as triangle strips." : ".") << detail::logInfoEnd;
+		}
+
+		/**
+		 * @brief Get the underlying buffer, e.g. to pass to VertexArray::bindElementBuffer().
+		 */
+		[[nodiscard]] const Buffer& getBuffer() const noexcept { return m_buffer; }
+		/**
+		 * @brief Get the type of the indices in the buffer.
+		 */
+		[[nodiscard]] IndexType getIndexType() const noexcept { return m_type; }
+		/**
+		 * @brief Get the primitive type the indices describe.
+		 */
+		[[nodiscard]] DrawMode getDrawMode() const noexcept { return m_mode; }
+		/**
+		 * @brief Get the number of indices in the buffer, including restart indices.
+		 */
+		[[nodiscard]] GLsizei getCount() const noexcept { return m_count; }
+		/**
+		 * @brief Check whether drawing the buffer requires primitive restart.
+		 */
+		[[nodiscard]] bool usesPrimitiveRestart() const noexcept { return m_primitiveRestart; }
+
+		/**
+		 * @brief Draw all indices in the buffer with the vertex array currently bound, which must have this buffer as
+		 * its element buffer. Enables or disables GL_PRIMITIVE_RESTART_FIXED_INDEX as needed.
+		 * @param instanceCount Number of instances to draw.
+		 */
+		void draw(const GLsizei instanceCount = 1) const noexcept
+		{
+			detail::setPrimitiveRestart(m_primitiveRestart);
+			glDrawElementsInstanced(static_cast<GLenum>(m_mode), m_count, static_cast<GLenum>(m_type), nullptr,
+				instanceCount);
+		}
+
+	private:
+		Buffer m_buffer;
+		IndexType m_type = IndexType::UnsignedInt;
+		DrawMode m_mode = DrawMode::Triangles;
+		GLsizei m_count = 0;
+		bool m_primitiveRestart = false;
+	};
+}
+
+#endif //GAL_INDEX_BUFFER_HPP
@@ -5,9 +5,20 @@
 #ifndef GAL_PROGRAM_HPP
 #define GAL_PROGRAM_HPP
 
-#include <unordered_map>
-
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "BlockLayout.hpp"
+#include "Buffer.hpp"
 #include "Shader.hpp"
+#include "ProgramReflection.hpp"
+#include "UniformLocation.hpp"
 
 namespace gal
 {
@@ -15,14 +26,227 @@ namespace gal
 	{
 		inline void programDeleter(const ProgramID id) noexcept
 		{
+			if (g_currentGLState)
+				g_currentGLState->forgetProgram(id);
 			glDeleteProgram(id);
 		}
 
 		using UniqueProgram = UniqueHandle<ProgramID, 0, programDeleter>;
+
+		/**
+		 * @brief Maps a uniform value type to the glProgramUniform*v function that uploads an array of it. Only
+		 * specialized for the types Program::setUniformArray() supports.
+		 */
+		template<typename T>
+		struct UniformTraits;
+
+		template<> struct UniformTraits<GLfloat>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const GLfloat* values,
+				bool) noexcept
+			{
+				glProgramUniform1fv(program, location, count, reinterpret_cast<const GLfloat*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::vec1>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::vec1* values,
+				bool) noexcept
+			{
+				glProgramUniform1fv(program, location, count, reinterpret_cast<const GLfloat*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::vec2>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::vec2* values,
+				bool) noexcept
+			{
+				glProgramUniform2fv(program, location, count, reinterpret_cast<const GLfloat*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::vec3>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::vec3* values,
+				bool) noexcept
+			{
+				glProgramUniform3fv(program, location, count, reinterpret_cast<const GLfloat*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::vec4>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::vec4* values,
+				bool) noexcept
+			{
+				glProgramUniform4fv(program, location, count, reinterpret_cast<const GLfloat*>(values));
+			}
+		};
+		template<> struct UniformTraits<GLint>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const GLint* values,
+				bool) noexcept
+			{
+				glProgramUniform1iv(program, location, count, reinterpret_cast<const GLint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::ivec1>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::ivec1* values,
+				bool) noexcept
+			{
+				glProgramUniform1iv(program, location, count, reinterpret_cast<const GLint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::ivec2>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::ivec2* values,
+				bool) noexcept
+			{
+				glProgramUniform2iv(program, location, count, reinterpret_cast<const GLint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::ivec3>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::ivec3* values,
+				bool) noexcept
+			{
+				glProgramUniform3iv(program, location, count, reinterpret_cast<const GLint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::ivec4>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::ivec4* values,
+				bool) noexcept
+			{
+				glProgramUniform4iv(program, location, count, reinterpret_cast<const GLint*>(values));
+			}
+		};
+		template<> struct UniformTraits<GLuint>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const GLuint* values,
+				bool) noexcept
+			{
+				glProgramUniform1uiv(program, location, count, reinterpret_cast<const GLuint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::uvec1>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::uvec1* values,
+				bool) noexcept
+			{
+				glProgramUniform1uiv(program, location, count, reinterpret_cast<const GLuint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::uvec2>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::uvec2* values,
+				bool) noexcept
+			{
+				glProgramUniform2uiv(program, location, count, reinterpret_cast<const GLuint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::uvec3>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::uvec3* values,
+				bool) noexcept
+			{
+				glProgramUniform3uiv(program, location, count, reinterpret_cast<const GLuint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::uvec4>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::uvec4* values,
+				bool) noexcept
+			{
+				glProgramUniform4uiv(program, location, count, reinterpret_cast<const GLuint*>(values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat2>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat2* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix2fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat3>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat3* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix3fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat4>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat4* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix4fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat2x3>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat2x3* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix2x3fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat3x2>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat3x2* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix3x2fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat2x4>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat2x4* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix2x4fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat4x2>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat4x2* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix4x2fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat3x4>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat3x4* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix3x4fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
+		template<> struct UniformTraits<glm::mat4x3>
+		{
+			static void upload(const ProgramID program, const GLint location, const GLsizei count, const glm::mat4x3* values,
+				const bool transpose) noexcept
+			{
+				glProgramUniformMatrix4x3fv(program, location, count, transpose, glm::value_ptr(*values));
+			}
+		};
 	}
 
 	/**
-	 * @brief Wrapper around an OpenGL shader program with uniform location caching.
+	 * @brief A linked program's binary, as retrieved with Program::getBinary().
+	 */
+	struct ProgramBinary
+	{
+		/// Driver-specific format of the binary.
+		GLenum format = 0;
+		std::vector<std::byte> data;
+	};
+
+	/**
+	 * @brief Wrapper around an OpenGL shader program with link-time uniform reflection. Uniform values are shadowed
+	 * per program, so setting a uniform to the value it already has doesn't reach OpenGL.
 	 */
 	class Program : detail::UniqueProgram
 	{
@@ -55,7 +279,43 @@ namespace gal
 		/**
 		 * @brief Make OpenGL use the program.
 		 */
-		void use() const noexcept { glUseProgram(getHandle()); }
+		void use() const noexcept { detail::useProgram(getHandle()); }
+
+		/**
+		 * @brief Use the program and launch its compute shader. Writes it makes through image stores, storage blocks
+		 * or atomic counters need a memory barrier before they're read (see BarrierTracker).
+		 * @param groupsX Number of work groups in the x dimension.
+		 * @param groupsY Number of work groups in the y dimension.
+		 * @param groupsZ Number of work groups in the z dimension.
+		 */
+		void dispatch(const GLuint groupsX, const GLuint groupsY = 1, const GLuint groupsZ = 1) const noexcept
+		{
+			use();
+			glDispatchCompute(groupsX, groupsY, groupsZ);
+		}
+
+		/**
+		 * @brief Use the program and launch its compute shader with work group counts read from a buffer, e.g. one
+		 * filled by an earlier dispatch.
+		 * @param buffer Buffer holding the three GLuint work group counts. Bound to BufferTarget::DispatchIndirect.
+		 * @param offset Offset of the counts within the buffer. Must be a multiple of 4.
+		 */
+		void dispatchIndirect(const Buffer& buffer, const GLintptr offset = 0) const noexcept
+		{
+			use();
+			buffer.bind(BufferTarget::DispatchIndirect);
+			glDispatchComputeIndirect(offset);
+		}
+
+		/**
+		 * @brief Get the local work group size declared by the program's compute shader.
+		 */
+		[[nodiscard]] std::array<GLint, 3> getComputeWorkGroupSize() const noexcept
+		{
+			std::array<GLint, 3> size{};
+			glGetProgramiv(getHandle(), GL_COMPUTE_WORK_GROUP_SIZE, size.data());
+			return size;
+		}
 
 		/**
 		 * @brief Attach a shader to the program.
@@ -87,16 +347,51 @@ namespace gal
 			detail::logInfoStart() << "Linking program ID " << getHandle() << "..." << detail::logInfoEnd;
 			detail::logIncreaseIndent();
 
-			glLinkProgram(getHandle());
+			linkAsync();
+			finishLink();
 
+			detail::logDecreaseIndent();
+		}
+
+		/**
+		 * @brief Start linking the program without waiting for the result. Attached shaders may still be compiling.
+		 * Poll isReady() and call finishLink() once it returns true, or call finishLink() directly to wait.
+		 */
+		void linkAsync() const noexcept { glLinkProgram(getHandle()); }
+
+		/**
+		 * @brief Check whether a link started with linkAsync() has finished, without blocking. Always true if the
+		 * driver doesn't support GL_KHR_parallel_shader_compile, in which case finishLink() may block.
+		 */
+		[[nodiscard]] bool isReady() const noexcept
+		{
+			if (!detail::g_parallelShaderCompileSupported)
+				return true;
+
+			GLint ready;
+			glGetProgramiv(getHandle(), GL_COMPLETION_STATUS_KHR, &ready);
+			return ready;
+		}
+
+		/**
+		 * @brief Wait for a link started with linkAsync() to finish, check that it succeeded, reflect the program and
+		 * detach all attached shaders.
+		 * @throws ErrCode::ProgramLinkFailed If program linking fails for any reason.
+		 */
+		void finishLink() const
+		{
 			GLint success;
 			glGetProgramiv(getHandle(), GL_LINK_STATUS, &success);
 			if (!success)
 			{
 #ifdef GAL_ERROR_LOGGING
-				GLint logLength;
+				GLint logLength = 0;
 				glGetProgramiv(getHandle(), GL_INFO_LOG_LENGTH, &logLength);
 
+				// Drivers may give no log at all.
+				if (logLength <= 0)
+					detail::throwErr(ErrCode::ProgramLinkFailed, "Failed to link program. OpenGL gave no error log.");
+
 				std::vector<GLchar> errorLog(logLength);
 				glGetProgramInfoLog(getHandle(), logLength, &logLength, errorLog.data());
 
@@ -107,7 +402,9 @@ namespace gal
 #endif
 			}
 
-			detail::logInfo("Successfully linked program.");
+			detail::logInfoStart() << "Successfully linked program ID " << getHandle() << "." << detail::logInfoEnd;
+			reflect();
+
 			detail::logInfo("Detaching shaders...");
 			detail::logIncreaseIndent();
 
@@ -123,118 +420,226 @@ namespace gal
 				detail::logInfoStart() << "Detached shader ID " << id << "." << detail::logInfoEnd;
 			}
 
-			detail::logDecreaseIndent(2);
+			detail::logDecreaseIndent();
+		}
+
+		/**
+		 * @brief Mark the program as separable, so it can be bound to the stages it contains in a ProgramPipeline and
+		 * mixed freely with other separable programs. Must be called before link().
+		 * @param separable Whether the program is separable.
+		 */
+		void setSeparable(const bool separable = true) const noexcept
+		{
+			glProgramParameteri(getHandle(), GL_PROGRAM_SEPARABLE, separable);
+		}
+
+		/**
+		 * @brief Check whether the program was marked separable with setSeparable().
+		 */
+		[[nodiscard]] bool isSeparable() const noexcept
+		{
+			GLint separable;
+			glGetProgramiv(getHandle(), GL_PROGRAM_SEPARABLE, &separable);
+			return separable;
+		}
+
+		/**
+		 * @brief Hint to the driver that the program's binary will be retrieved with getBinary() once it's linked. Must
+		 * be called before link() for the binary to be reliably retrievable.
+		 * @param retrievable Whether the binary will be retrieved.
+		 */
+		void setBinaryRetrievable(const bool retrievable = true) const noexcept
+		{
+			glProgramParameteri(getHandle(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, retrievable);
+		}
+
+		/**
+		 * @brief Get the binary of the linked program, to be loaded later with loadBinary().
+		 * @return The binary, with empty data if the driver didn't provide one.
+		 */
+		[[nodiscard]] ProgramBinary getBinary() const
+		{
+			ProgramBinary binary;
+
+			GLint length = 0;
+			glGetProgramiv(getHandle(), GL_PROGRAM_BINARY_LENGTH, &length);
+			if (length <= 0)
+				return binary;
+
+			binary.data.resize(length);
+			glGetProgramBinary(getHandle(), length, &length, &binary.format, binary.data.data());
+			binary.data.resize(length);
+			return binary;
+		}
+
+		/**
+		 * @brief Link the program from a binary retrieved earlier with getBinary() instead of from attached shaders.
+		 * @param format Driver-specific format of the binary.
+		 * @param data Pointer to the binary.
+		 * @param size Size of the binary in bytes.
+		 * @return True if the program was linked. Drivers reject binaries after updates or hardware changes, in which
+		 * case false is returned and the program must be linked from source as usual.
+		 */
+		[[nodiscard]] bool loadBinary(const GLenum format, const void* data, const GLsizei size) const
+		{
+			detail::logInfoStart() << "Loading binary of program ID " << getHandle() << "..." << detail::logInfoEnd;
+			detail::logIncreaseIndent();
+
+			glProgramBinary(getHandle(), format, data, size);
+
+			GLint success;
+			glGetProgramiv(getHandle(), GL_LINK_STATUS, &success);
+			if (!success)
+			{
+				detail::logWarn("Program binary was rejected by the driver.");
+				detail::logDecreaseIndent();
+				return false;
+			}
+
+			detail::logInfo("Successfully loaded program binary.");
+			reflect();
+			detail::logDecreaseIndent();
+			return true;
+		}
+
+		/**
+		 * @brief Link the program from a binary retrieved earlier with getBinary() instead of from attached shaders.
+		 * @param binary The binary to load.
+		 * @return True if the program was linked, false if the driver rejected the binary.
+		 */
+		[[nodiscard]] bool loadBinary(const ProgramBinary& binary) const
+		{
+			return loadBinary(binary.format, binary.data.data(), static_cast<GLsizei>(binary.data.size()));
 		}
 		
 		// ========== float uniform setters ==========
 
 		/**
 		 * @brief Set a float uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val Value to assign to the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLfloat val) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLfloat val) const
 		{
-			glProgramUniform1f(getHandle(), getUniformLocation(name), val);
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, &val, sizeof(val)))
+				glProgramUniform1f(getHandle(), loc, val);
 			return *this;
 		}
 
 		/**
 		 * @brief Set a float uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 1-component vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::vec1& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::vec1& vec) const
 		{
-			glProgramUniform1fv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform1fv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a float vector uniform with two components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLfloat val1, const GLfloat val2) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLfloat val1, const GLfloat val2) const
 		{
-			glProgramUniform2f(getHandle(), getUniformLocation(name), val1, val2);
+			const GLint loc = resolveUniform(uniform);
+			const GLfloat vals[] = {val1, val2};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform2f(getHandle(), loc, val1, val2);
 			return *this;
 		}
 
 		/**
 		 * @brief Set a float vector uniform with two components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 2-component vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::vec2& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::vec2& vec) const
 		{
-			glProgramUniform2fv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform2fv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a float vector uniform with three components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @param val3 Third component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLfloat val1, const GLfloat val2, const GLfloat val3) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLfloat val1, const GLfloat val2, const GLfloat val3) const
 		{
-			glProgramUniform3f(getHandle(), getUniformLocation(name), val1, val2, val3);
+			const GLint loc = resolveUniform(uniform);
+			const GLfloat vals[] = {val1, val2, val3};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform3f(getHandle(), loc, val1, val2, val3);
 			return *this;
 		}
 
 		/**
 		 * @brief Set a float vector uniform with three components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 3-component vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::vec3& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::vec3& vec) const
 		{
-			glProgramUniform3fv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform3fv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a float vector uniform with four components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @param val3 Third component of the uniform.
 		 * @param val4 Fourth component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLfloat val1, const GLfloat val2, const GLfloat val3, const GLfloat val4) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLfloat val1, const GLfloat val2, const GLfloat val3, const GLfloat val4) const
 		{
-			glProgramUniform4f(getHandle(), getUniformLocation(name), val1, val2, val3, val4);
+			const GLint loc = resolveUniform(uniform);
+			const GLfloat vals[] = {val1, val2, val3, val4};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform4f(getHandle(), loc, val1, val2, val3, val4);
 			return *this;
 		}
 
 		/**
 		 * @brief Set a float vector uniform with four components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 4-component vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::vec4& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::vec4& vec) const
 		{
-			glProgramUniform4fv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform4fv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
@@ -242,124 +647,146 @@ namespace gal
 
 		/**
 		 * @brief Set a boolean uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val Boolean value to assign to the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const bool val) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const bool val) const
 		{
-			glProgramUniform1i(getHandle(), getUniformLocation(name), static_cast<int>(val));
+			const GLint loc = resolveUniform(uniform);
+			const GLint intVal = static_cast<GLint>(val);
+			if (shadowUniform(loc, &intVal, sizeof(intVal)))
+				glProgramUniform1i(getHandle(), loc, intVal);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an integer uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val Integer value to assign to the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLint val) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLint val) const
 		{
-			glProgramUniform1i(getHandle(), getUniformLocation(name), val);
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, &val, sizeof(val)))
+				glProgramUniform1i(getHandle(), loc, val);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an integer uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 1-component integer vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::ivec1& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::ivec1& vec) const
 		{
-			glProgramUniform1iv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform1iv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set an integer vector uniform with two components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLint val1, const GLint val2) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLint val1, const GLint val2) const
 		{
-			glProgramUniform2i(getHandle(), getUniformLocation(name), val1, val2);
+			const GLint loc = resolveUniform(uniform);
+			const GLint vals[] = {val1, val2};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform2i(getHandle(), loc, val1, val2);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an integer vector uniform with two components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 2-component integer vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::ivec2& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::ivec2& vec) const
 		{
-			glProgramUniform2iv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform2iv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set an integer vector uniform with three components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @param val3 Third component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLint val1, const GLint val2, const GLint val3) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLint val1, const GLint val2, const GLint val3) const
 		{
-			glProgramUniform3i(getHandle(), getUniformLocation(name), val1, val2, val3);
+			const GLint loc = resolveUniform(uniform);
+			const GLint vals[] = {val1, val2, val3};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform3i(getHandle(), loc, val1, val2, val3);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an integer vector uniform with three components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 3-component integer vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::ivec3& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::ivec3& vec) const
 		{
-			glProgramUniform3iv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform3iv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set an integer vector uniform with four components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @param val3 Third component of the uniform.
 		 * @param val4 Fourth component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLint val1, const GLint val2, const GLint val3, const GLint val4) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLint val1, const GLint val2, const GLint val3, const GLint val4) const
 		{
-			glProgramUniform4i(getHandle(), getUniformLocation(name), val1, val2, val3, val4);
+			const GLint loc = resolveUniform(uniform);
+			const GLint vals[] = {val1, val2, val3, val4};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform4i(getHandle(), loc, val1, val2, val3, val4);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an integer vector uniform with four components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 4-component integer vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::ivec4& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::ivec4& vec) const
 		{
-			glProgramUniform4iv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform4iv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
@@ -367,111 +794,130 @@ namespace gal
 
 		/**
 		 * @brief Set an unsigned integer uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val Unsigned integer value to assign to the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLuint val) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLuint val) const
 		{
-			glProgramUniform1ui(getHandle(), getUniformLocation(name), val);
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, &val, sizeof(val)))
+				glProgramUniform1ui(getHandle(), loc, val);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an unsigned integer uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 1-component unsigned integer vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::uvec1& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::uvec1& vec) const
 		{
-			glProgramUniform1uiv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform1uiv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set an unsigned integer vector uniform with two components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLuint val1, const GLuint val2) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLuint val1, const GLuint val2) const
 		{
-			glProgramUniform2ui(getHandle(), getUniformLocation(name), val1, val2);
+			const GLint loc = resolveUniform(uniform);
+			const GLuint vals[] = {val1, val2};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform2ui(getHandle(), loc, val1, val2);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an unsigned integer vector uniform with two components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 2-component unsigned integer vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::uvec2& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::uvec2& vec) const
 		{
-			glProgramUniform2uiv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform2uiv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set an unsigned integer vector uniform with three components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @param val3 Third component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLuint val1, const GLuint val2, const GLuint val3) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLuint val1, const GLuint val2, const GLuint val3) const
 		{
-			glProgramUniform3ui(getHandle(), getUniformLocation(name), val1, val2, val3);
+			const GLint loc = resolveUniform(uniform);
+			const GLuint vals[] = {val1, val2, val3};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform3ui(getHandle(), loc, val1, val2, val3);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an unsigned integer vector uniform with three components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 3-component unsigned integer vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::uvec3& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::uvec3& vec) const
 		{
-			glProgramUniform3uiv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform3uiv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
 		/**
 		 * @brief Set an unsigned integer vector uniform with four components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param val1 First component of the uniform.
 		 * @param val2 Second component of the uniform.
 		 * @param val3 Third component of the uniform.
 		 * @param val4 Fourth component of the uniform.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const GLuint val1, const GLuint val2, const GLuint val3, const GLuint val4) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const GLuint val1, const GLuint val2, const GLuint val3, const GLuint val4) const
 		{
-			glProgramUniform4ui(getHandle(), getUniformLocation(name), val1, val2, val3, val4);
+			const GLint loc = resolveUniform(uniform);
+			const GLuint vals[] = {val1, val2, val3, val4};
+			if (shadowUniform(loc, vals, sizeof(vals)))
+				glProgramUniform4ui(getHandle(), loc, val1, val2, val3, val4);
 			return *this;
 		}
 
 		/**
 		 * @brief Set an unsigned integer vector uniform with four components.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param vec Value to assign to the uniform as a 4-component unsigned integer vector.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::uvec4& vec) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::uvec4& vec) const
 		{
-			glProgramUniform4uiv(getHandle(), getUniformLocation(name), 1, glm::value_ptr(vec));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(vec), sizeof(vec)))
+				glProgramUniform4uiv(getHandle(), loc, 1, glm::value_ptr(vec));
 			return *this;
 		}
 
@@ -480,145 +926,663 @@ namespace gal
 
 		/**
 		 * @brief Set a 2x2 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat2& mat, const bool transpose = false) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat2& mat, const bool transpose = false) const
 		{
-			glProgramUniformMatrix2fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix2fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a 3x3 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat3& mat, const bool transpose = false) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat3& mat, const bool transpose = false) const
 		{
-			glProgramUniformMatrix3fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix3fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a 4x4 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat4& mat, const bool transpose = false) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat4& mat, const bool transpose = false) const
 		{
-			glProgramUniformMatrix4fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix4fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a 2x3 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat2x3& mat, const bool transpose = false) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat2x3& mat, const bool transpose = false) const
 		{
-			glProgramUniformMatrix2x3fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix2x3fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a 3x2 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat3x2& mat, const bool transpose = false) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat3x2& mat, const bool transpose = false) const
 		{
-			glProgramUniformMatrix3x2fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix3x2fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a 2x4 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat2x4& mat, const bool transpose = false) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat2x4& mat, const bool transpose = false) const
 		{
-			glProgramUniformMatrix2x4fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix2x4fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a 4x2 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat4x2& mat, const bool transpose = false) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat4x2& mat, const bool transpose = false) const
 		{
-			glProgramUniformMatrix4x2fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix4x2fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a 3x4 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat3x4& mat, const bool transpose = false) const
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat3x4& mat, const bool transpose = false) const
 		{
-			glProgramUniformMatrix3x4fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix3x4fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
 			return *this;
 		}
 
 		/**
 		 * @brief Set a 4x3 matrix uniform.
-		 * @param name Name of the uniform to set.
+		 * @param uniform Name or pre-resolved location of the uniform to set.
 		 * @param mat Matrix value to assign to the uniform.
 		 * @param transpose Whether to transpose the matrix when uploading.
 		 * @return Const reference to this Program object for chaining together multiple uniform sets.
-		 * @throws ErrCode::NonExistentShaderUniform If the given uniform does not exist.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
+		 */
+		[[maybe_unused]] const Program& setUniform(const UniformRef& uniform, const glm::mat4x3& mat, const bool transpose = false) const
+		{
+			const GLint loc = resolveUniform(uniform);
+			if (shadowUniform(loc, glm::value_ptr(mat), sizeof(mat), transpose))
+				glProgramUniformMatrix4x3fv(getHandle(), loc, 1, transpose, glm::value_ptr(mat));
+			return *this;
+		}
+
+		// ========== array and batch uniform setters ==========
+
+		/**
+		 * @brief Set consecutive elements of a uniform array with a single OpenGL call.
+		 * @tparam T Element type. Any scalar, vector or matrix type setUniform() accepts, except bool.
+		 * @param uniform Name or pre-resolved location of the array (or of the element to start counting from).
+		 * @param values Pointer to the element values.
+		 * @param count Number of elements to set. Elements past the end of the array are ignored.
+		 * @param firstElement Index of the first element to set. Nothing is set if it's negative or past the end of
+		 * the array.
+		 * @param transpose Whether to transpose matrices as they're uploaded. Ignored for non-matrix types.
+		 * @return Const reference to this Program object for chaining together multiple uniform sets.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
 		 */
-		[[maybe_unused]] const Program& setUniform(const std::string& name, const glm::mat4x3& mat, const bool transpose = false) const
+		template<typename T>
+		[[maybe_unused]] const Program& setUniformArray(const UniformRef& uniform, const T* values, const GLsizei count,
+			const GLint firstElement = 0, const bool transpose = false) const
 		{
-			glProgramUniformMatrix4x3fv(getHandle(), getUniformLocation(name), 1, transpose, glm::value_ptr(mat));
+			GLint loc = resolveUniform(uniform);
+			if (loc == -1 || count <= 0)
+				return *this;
+
+			// Only write the shadow slots of elements that exist; the locations past the end belong to other uniforms.
+			const GLint elementsLeft = loc < static_cast<GLint>(m_arrayElementsLeft.size()) ? m_arrayElementsLeft[loc] : 0;
+			if (firstElement < 0 || firstElement >= elementsLeft)
+			{
+				detail::logWarnStart() << "Element " << firstElement << " is outside the uniform array at location " <<
+					loc << " in program ID " << getHandle() << ". Setting it will have no effect." << detail::logWarnEnd;
+				return *this;
+			}
+
+			loc += firstElement;
+			const GLsizei setCount = std::min(count, elementsLeft - firstElement);
+			if (shadowUniformArray(loc, values, sizeof(T), setCount, transpose))
+				detail::UniformTraits<T>::upload(getHandle(), loc, setCount, values, transpose);
 			return *this;
 		}
 
+		/**
+		 * @brief Set consecutive elements of a uniform array with a single OpenGL call.
+		 * @tparam Container Container type. This can be anything that has a .data() and .size() method and stores
+		 * elements contiguously in memory (e.g., std::array, std::vector, etc.), with elements of any scalar, vector or
+		 * matrix type setUniform() accepts, except bool.
+		 * @param uniform Name or pre-resolved location of the array (or of the element to start counting from).
+		 * @param values The container with the element values.
+		 * @param firstElement Index of the first element to set.
+		 * @param transpose Whether to transpose matrices as they're uploaded. Ignored for non-matrix types.
+		 * @return Const reference to this Program object for chaining together multiple uniform sets.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
+		 */
+		template<typename Container>
+		[[maybe_unused]] auto setUniformArray(const UniformRef& uniform, const Container& values,
+			const GLint firstElement = 0, const bool transpose = false) const
+			-> std::enable_if_t<
+				std::is_pointer_v<decltype(values.data())> &&
+				std::is_integral_v<decltype(values.size())>,
+				const Program&
+			>
+		{
+			return setUniformArray(uniform, values.data(), static_cast<GLsizei>(values.size()), firstElement, transpose);
+		}
+
+		/**
+		 * @brief Set several uniforms at once, e.g. @code program.setUniforms({{"time", t}, {"model", model}}); @endcode
+		 * Each uniform's location is resolved once and its value goes through the same shadowing as setUniform().
+		 * @param assignments Uniforms to set along with their values.
+		 * @return Const reference to this Program object for chaining together multiple uniform sets.
+		 * @throws ErrCode::NonExistentShaderUniform If a uniform is given by name before the program was linked.
+		 */
+		[[maybe_unused]] const Program& setUniforms(const std::initializer_list<UniformAssignment> assignments) const
+		{
+			for (const auto& assignment : assignments)
+			{
+				const UniformLocation loc{resolveUniform(assignment.uniform)};
+				std::visit([&](const auto& value) { setUniform(loc, value); }, assignment.value);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Look up a uniform's location ahead of time, so setting it later is free of any name lookup.
+		 * @param name Name of the uniform. Elements of arrays of basic types may be named with a subscript.
+		 * @return The uniform's location, valid until the program is relinked. If the uniform isn't active (e.g.,
+		 * because the compiler optimized it out), the location is invalid and setting it is a no-op.
+		 */
+		[[nodiscard]] UniformLocation getUniformLocation(const UniformName name) const
+		{
+			return UniformLocation{lookUpUniform(name)};
+		}
+
+		/**
+		 * @brief Get every active uniform reflected when the program was linked, including uniform block members.
+		 */
+		[[nodiscard]] const std::vector<UniformInfo>& getActiveUniforms() const noexcept { return m_reflection.uniforms; }
+		/**
+		 * @brief Get every active uniform block reflected when the program was linked.
+		 */
+		[[nodiscard]] const std::vector<BlockInfo>& getUniformBlocks() const noexcept { return m_reflection.uniformBlocks; }
+		/**
+		 * @brief Get every active shader storage block reflected when the program was linked.
+		 */
+		[[nodiscard]] const std::vector<BlockInfo>& getStorageBlocks() const noexcept { return m_reflection.storageBlocks; }
+
+		/**
+		 * @brief Find an active uniform by name without querying OpenGL.
+		 * @return The reflected uniform, or nullptr if it isn't active. Arrays of basic types are named "name[0]".
+		 */
+		[[nodiscard]] const UniformInfo* findUniform(const UniformName name) const noexcept
+		{
+			return detail::findByName(m_reflection.uniforms, name);
+		}
+		/**
+		 * @brief Find an active uniform block by name without querying OpenGL.
+		 * @return The reflected block, or nullptr if it isn't active.
+		 */
+		[[nodiscard]] const BlockInfo* findUniformBlock(const UniformName name) const noexcept
+		{
+			return detail::findByName(m_reflection.uniformBlocks, name);
+		}
+		/**
+		 * @brief Find an active shader storage block by name without querying OpenGL.
+		 * @return The reflected block, or nullptr if it isn't active.
+		 */
+		[[nodiscard]] const BlockInfo* findStorageBlock(const UniformName name) const noexcept
+		{
+			return detail::findByName(m_reflection.storageBlocks, name);
+		}
+		/**
+		 * @brief Get every active shader storage block member reflected when the program was linked.
+		 */
+		[[nodiscard]] const std::vector<UniformInfo>& getBufferVariables() const noexcept
+		{
+			return m_reflection.bufferVariables;
+		}
+		/**
+		 * @brief Find an active shader storage block member by name without querying OpenGL.
+		 * @return The reflected member, or nullptr if it isn't active. Members are named as OpenGL reports them, e.g.
+		 * "Block.member" and "Block.array[0]".
+		 */
+		[[nodiscard]] const UniformInfo* findBufferVariable(const UniformName name) const noexcept
+		{
+			return detail::findByName(m_reflection.bufferVariables, name);
+		}
+
+		/**
+		 * @brief Assign a uniform block to a buffer binding index, so a buffer bound there with Buffer::bindIndexed()
+		 * (IndexedBufferTarget::Uniform) backs the block. Nothing is uploaded if it's already assigned there.
+		 * @param name Name of the block.
+		 * @param binding The binding index.
+		 * @return Const reference to this Program object for chaining.
+		 */
+		[[maybe_unused]] const Program& bindUniformBlock(const UniformName name, const GLuint binding) const
+		{
+			if (BlockInfo* block = findBlockForBinding(m_reflection.uniformBlocks, name, "Uniform"))
+				if (block->binding != static_cast<GLint>(binding))
+				{
+					glUniformBlockBinding(getHandle(), block->index, binding);
+					block->binding = static_cast<GLint>(binding);
+				}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Assign a shader storage block to a buffer binding index, so a buffer bound there with
+		 * Buffer::bindIndexed() (IndexedBufferTarget::ShaderStorage) backs the block. Nothing is uploaded if it's
+		 * already assigned there.
+		 * @param name Name of the block.
+		 * @param binding The binding index.
+		 * @return Const reference to this Program object for chaining.
+		 */
+		[[maybe_unused]] const Program& bindStorageBlock(const UniformName name, const GLuint binding) const
+		{
+			if (BlockInfo* block = findBlockForBinding(m_reflection.storageBlocks, name, "Storage"))
+				if (block->binding != static_cast<GLint>(binding))
+				{
+					glShaderStorageBlockBinding(getHandle(), block->index, binding);
+					block->binding = static_cast<GLint>(binding);
+				}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Check that a C++ struct matches the layout of a uniform block as reflected at link time, so it can be
+		 * uploaded to the block's buffer in one write. Check the struct against the layout rules at compile time with
+		 * matchesBlockLayout() too, which catches most mistakes before the program is even built.
+		 * @tparam Block The C++ struct.
+		 * @param name Name of the block.
+		 * @param members Every member of the struct, in declaration order. Each must be an active member of the block
+		 * with the same name, type and placement.
+		 * @return True if the struct matches. If not, and GAL_WARNING_LOGGING is defined, every mismatch is printed to
+		 * the console.
+		 */
+		template<typename Block, std::size_t N>
+		[[nodiscard]] bool validateUniformBlock(const UniformName name, const BlockMember (&members)[N]) const
+		{
+			return validateBlock(findUniformBlock(name), m_reflection.uniforms, name, members, N, sizeof(Block));
+		}
+
+		/**
+		 * @brief Check that a C++ struct matches the layout of a shader storage block as reflected at link time.
+		 * @tparam Block The C++ struct. If the block ends in an unsized array, the struct should cover everything
+		 * before it.
+		 * @param name Name of the block.
+		 * @param members Every member of the struct, in declaration order.
+		 * @return True if the struct matches. If not, and GAL_WARNING_LOGGING is defined, every mismatch is printed to
+		 * the console.
+		 */
+		template<typename Block, std::size_t N>
+		[[nodiscard]] bool validateStorageBlock(const UniformName name, const BlockMember (&members)[N]) const
+		{
+			return validateBlock(findStorageBlock(name), m_reflection.bufferVariables, name, members, N, sizeof(Block));
+		}
+
+		/**
+		 * @brief Get the number of uniform uploads skipped because the value being set was already the current one.
+		 */
+		[[nodiscard]] std::size_t getSkippedUniformUploads() const noexcept { return m_skippedUniformUploads; }
+		/**
+		 * @brief Get the number of uniform uploads that went through to OpenGL.
+		 */
+		[[nodiscard]] std::size_t getUniformUploads() const noexcept { return m_uniformUploads; }
+		/**
+		 * @brief Reset the counters returned by getSkippedUniformUploads() and getUniformUploads().
+		 */
+		void resetUniformUploadStats() const noexcept
+		{
+			m_skippedUniformUploads = 0;
+			m_uniformUploads = 0;
+		}
+
+		/**
+		 * @brief Forget the shadow copy of every uniform value, so the next set of each uniform always reaches OpenGL.
+		 * Call this after setting this program's uniforms with raw OpenGL calls.
+		 */
+		void invalidateUniformShadow() const noexcept
+		{
+			m_shadowSlots.clear();
+			m_shadowData.clear();
+		}
+
 	private:
-		mutable std::unordered_map<std::string, GLint> m_uniformLocations;
+		struct CachedUniformLocation
+		{
+			std::uint64_t hash;
+			std::string name;
+			GLint location;
+		};
+
+		mutable ProgramReflection m_reflection;
+		// Sorted by hash so lookups are a binary search that never allocates. Holds every loose uniform reflected at
+		// link time, plus array elements and inactive names (with location -1) as they're first looked up.
+		mutable std::vector<CachedUniformLocation> m_uniformLocations;
+		// Number of array elements from each location to the end of the uniform it belongs to (1 for non-arrays), or 0
+		// for locations no reflected uniform has.
+		mutable std::vector<GLint> m_arrayElementsLeft;
+		mutable bool m_reflected = false;
+
+		struct ShadowSlot
+		{
+			std::uint32_t offset = 0;
+			std::uint32_t size = 0; // 0 if the uniform hasn't been set through this program yet.
+			std::uint32_t capacity = 0; // Bytes reserved at offset, which later values of any size up to it reuse.
+			bool transpose = false;
+		};
+
+		// Shadow copy of the last value set at each uniform location, indexed by location, with the values themselves
+		// packed into m_shadowData.
+		mutable std::vector<ShadowSlot> m_shadowSlots;
+		mutable std::vector<std::byte> m_shadowData;
+		mutable std::size_t m_skippedUniformUploads = 0;
+		mutable std::size_t m_uniformUploads = 0;
 
-		GLint getUniformLocation(const std::string& name) const
+		/**
+		 * @brief Reflect the freshly linked program and rebuild the uniform location table from it.
+		 */
+		void reflect() const
 		{
-			if (const auto it = m_uniformLocations.find(name); it != m_uniformLocations.end())
-				return it->second;
+			m_reflection = detail::reflectProgram(getHandle());
+			m_reflected = true;
+			m_uniformLocations.clear();
+			m_arrayElementsLeft.clear();
+			invalidateUniformShadow();
+
+			for (const auto& uniform : m_reflection.uniforms)
+			{
+				if (uniform.location == -1)
+					continue;
+
+				m_uniformLocations.push_back({uniform.hash, uniform.name, uniform.location});
+
+				const GLint arraySize = std::max(uniform.arraySize, 1);
+				if (m_arrayElementsLeft.size() < static_cast<std::size_t>(uniform.location + arraySize))
+					m_arrayElementsLeft.resize(uniform.location + arraySize, 0);
+				for (GLint i = 0; i < arraySize; ++i)
+					m_arrayElementsLeft[uniform.location + i] = arraySize - i;
+
+				// Also allow arrays to be referred to without the [0] subscript, as glGetUniformLocation does.
+				const std::size_t nameLength = uniform.name.size();
+				if (nameLength > 3 && uniform.name.compare(nameLength - 3, 3, "[0]") == 0)
+				{
+					std::string baseName = uniform.name.substr(0, nameLength - 3);
+					const std::uint64_t hash = detail::fnv1a(baseName);
+					m_uniformLocations.push_back({hash, std::move(baseName), uniform.location});
+				}
+			}
 
-			const GLint loc = glGetUniformLocation(getHandle(), name.c_str());
+			detail::sortByHash(m_uniformLocations);
+		}
+
+		/**
+		 * @brief Compare a value about to be set against the shadow copy for its location and update the copy.
+		 * @param location Location being set. Nothing is uploaded for -1.
+		 * @param data The value being set.
+		 * @param size Size of the value in bytes.
+		 * @param transpose Whether a matrix value is being uploaded transposed.
+		 * @return True if the value differs from the last one set and must be uploaded.
+		 */
+		bool shadowUniform(const GLint location, const void* data, const std::size_t size,
+			const bool transpose = false) const
+		{
+			if (location < 0)
+				return false;
+
+			const bool changed = updateShadowSlot(location, data, size, transpose);
+			++(changed ? m_uniformUploads : m_skippedUniformUploads);
+			return changed;
+		}
+
+		/**
+		 * @brief Like shadowUniform(), but for consecutive array elements, which each have their own location.
+		 * @return True if any element differs from the last value set for it, in which case all of them must be
+		 * uploaded.
+		 */
+		bool shadowUniformArray(const GLint location, const void* data, const std::size_t elementSize,
+			const GLsizei count, const bool transpose) const
+		{
+			if (location < 0)
+				return false;
+
+			const auto* bytes = static_cast<const std::byte*>(data);
+			bool changed = false;
+			for (GLsizei i = 0; i < count; ++i)
+				changed |= updateShadowSlot(location + i, bytes + i * elementSize, elementSize, transpose);
+
+			++(changed ? m_uniformUploads : m_skippedUniformUploads);
+			return changed;
+		}
+
+		bool updateShadowSlot(const GLint location, const void* data, const std::size_t size,
+			const bool transpose) const
+		{
+			if (static_cast<std::size_t>(location) >= m_shadowSlots.size())
+				m_shadowSlots.resize(location + 1);
+
+			ShadowSlot& slot = m_shadowSlots[location];
+			if (slot.size == size && slot.transpose == transpose &&
+				std::memcmp(m_shadowData.data() + slot.offset, data, size) == 0)
+				return false;
+
+			// Values set at a location with a new, larger size (e.g. through a differently typed setter) get new space;
+			// smaller ones reuse the slot's, so the shadow never grows past the largest value set at each location.
+			if (size > slot.capacity)
+			{
+				slot.offset = static_cast<std::uint32_t>(m_shadowData.size());
+				slot.capacity = static_cast<std::uint32_t>(size);
+				m_shadowData.resize(m_shadowData.size() + size);
+			}
+			slot.size = static_cast<std::uint32_t>(size);
+
+			slot.transpose = transpose;
+			std::memcpy(m_shadowData.data() + slot.offset, data, size);
+			return true;
+		}
+
+		BlockInfo* findBlockForBinding(std::vector<BlockInfo>& blocks, const UniformName& name,
+			const char* kind) const
+		{
+			BlockInfo* block = detail::findByName(blocks, name);
+			if (!block)
+				detail::logWarnStart() << kind << " block \"" << name.getName() << "\" is not active in program ID " <<
+					getHandle() << ". Binding it will have no effect." << detail::logWarnEnd;
+			return block;
+		}
+
+		bool validateBlock(const BlockInfo* block, const std::vector<UniformInfo>& variables, const UniformName& name,
+			const BlockMember* members, const std::size_t count, const std::size_t structSize) const
+		{
+			if (!block)
+			{
+				detail::logWarnStart() << "Block \"" << name.getName() << "\" is not active in program ID " <<
+					getHandle() << "." << detail::logWarnEnd;
+				return false;
+			}
+
+			bool valid = true;
+			const auto mismatch = [&](const BlockMember& member, const char* problem)
+			{
+				detail::logWarnStart() << "Member \"" << member.name << "\" of block \"" << name.getName() <<
+					"\" in program ID " << getHandle() << " " << problem << "." << detail::logWarnEnd;
+				valid = false;
+			};
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const BlockMember& member = members[i];
+
+				// Members of blocks with an instance name are reported as "Block.member", others as just "member".
+				std::string memberName = member.name;
+				if (member.arraySize > 0)
+					memberName += "[0]";
+				const UniformInfo* variable = detail::findByName(variables,
+					std::string{name.getName()} + "." + memberName);
+				if (!variable)
+					variable = detail::findByName(variables, memberName);
+
+				const std::size_t columns = detail::getBlockTypeShape(member.type)[0];
+				if (!variable || variable->blockIndex != static_cast<GLint>(block->index))
+					mismatch(member, "is not active in the block");
+				else if (variable->type != member.type)
+					mismatch(member, "has a different type in GLSL");
+				else if (variable->offset != static_cast<GLint>(member.offset))
+					mismatch(member, "is at a different offset in GLSL");
+				else if (member.arraySize > 0 && (variable->arraySize != static_cast<GLint>(member.arraySize) ||
+					variable->arrayStride != static_cast<GLint>(member.elementSize)))
+					mismatch(member, "has a different array size or stride in GLSL");
+				else if (columns > 1 && variable->matrixStride != static_cast<GLint>(member.elementSize / columns))
+					mismatch(member, "has a different matrix stride in GLSL");
+			}
+
+			if (structSize < static_cast<std::size_t>(block->dataSize) && block->dataSize > 0)
+			{
+				// Storage blocks ending in an unsized array report a size with one element in it.
+				const bool unsizedArray = std::any_of(variables.begin(), variables.end(), [&](const UniformInfo& variable)
+				{
+					return variable.blockIndex == static_cast<GLint>(block->index) && variable.arraySize == 0;
+				});
+				if (!unsizedArray)
+				{
+					detail::logWarnStart() << "Block \"" << name.getName() << "\" in program ID " << getHandle() <<
+						" needs " << block->dataSize << " bytes but its struct only has " << structSize << "." <<
+						detail::logWarnEnd;
+					valid = false;
+				}
+			}
+
+			return valid;
+		}
+
+		/**
+		 * @brief Get the location a uniform setter writes to. Inactive uniforms, given by name or by an invalid
+		 * location, resolve to -1, which the setters treat as a no-op.
+		 * @throws ErrCode::NonExistentShaderUniform If the uniform is given by name and the program was never linked,
+		 * so there are no reflected uniforms to look it up in.
+		 */
+		GLint resolveUniform(const UniformRef& uniform) const
+		{
+			if (uniform.isResolved())
+				return uniform.getLocation();
+
+			if (!m_reflected)
+			{
+				detail::logErrStart() << "Attempted to set uniform \"" << uniform.getName().getName() <<
+					"\" of program ID " << getHandle() << " before linking it." << detail::logErrEnd;
+				detail::throwErr(ErrCode::NonExistentShaderUniform, "Attempted to set a non-existent shader uniform.");
+			}
+			return lookUpUniform(uniform.getName());
+		}
+
+		GLint lookUpUniform(const UniformName& name) const
+		{
+			if (const auto* cached = detail::findByName(m_uniformLocations, name))
+				return cached->location;
+
+			// Not a reflected name. It may still be an element of a reflected array, whose locations are consecutive;
+			// otherwise the uniform isn't active and -1 is cached so this, and the warning, happen once per name.
+			const GLint loc = arrayElementLocation(name.getName());
 			if (loc == -1)
-				detail::throwErr(ErrCode::NonExistentShaderUniform, "Attempted to set non-existent shader uniform.");
+				detail::logWarnStart() << "Uniform \"" << name.getName() << "\" is not active in program ID " <<
+					getHandle() << ". Setting it will have no effect." << detail::logWarnEnd;
 
-			m_uniformLocations[name] = loc;
+			const auto it = std::lower_bound(m_uniformLocations.begin(), m_uniformLocations.end(), name.getHash(),
+				[](const CachedUniformLocation& entry, const std::uint64_t hash) { return entry.hash < hash; });
+			m_uniformLocations.insert(it, {name.getHash(), std::string{name.getName()}, loc});
 			return loc;
 		}
+
+		/**
+		 * @brief Get the location of an array element named "name[i]" from the reflected array it belongs to.
+		 * @return The element's location, or -1 if the name isn't an in-bounds element of an active array.
+		 */
+		GLint arrayElementLocation(const std::string_view name) const
+		{
+			const std::size_t open = name.rfind('[');
+			if (open == std::string_view::npos || name.back() != ']' || open + 2 >= name.size())
+				return -1;
+
+			GLint element = 0;
+			for (std::size_t i = open + 1; i < name.size() - 1; ++i)
+			{
+				if (name[i] < '0' || name[i] > '9')
+					return -1;
+				element = element * 10 + (name[i] - '0');
+			}
+
+			std::string firstElementName{name.substr(0, open)};
+			firstElementName += "[0]";
+			const UniformInfo* array = findUniform(firstElementName);
+			if (!array || array->location == -1 || element >= array->arraySize)
+				return -1;
+
+			return array->location + element;
+		}
 	};
 }
 
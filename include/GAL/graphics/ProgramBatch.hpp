@@ -0,0 +1,230 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_PROGRAM_BATCH_HPP
+#define GAL_PROGRAM_BATCH_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Program.hpp"
+#include "ProgramBinaryCache.hpp"
+#include "Shader.hpp"
+#include "ShaderCache.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief Check whether the driver supports GL_KHR_parallel_shader_compile (or GL_ARB_parallel_shader_compile),
+	 * i.e., whether shaders and programs can be polled for completion without blocking.
+	 */
+	[[nodiscard]] inline bool isParallelShaderCompileSupported() noexcept
+	{
+		return detail::g_parallelShaderCompileSupported;
+	}
+
+	/**
+	 * @brief Set the number of threads the driver may use to compile shaders in the background. Has no effect if
+	 * parallel shader compilation isn't supported.
+	 * @param count Maximum number of compiler threads. 0xFFFFFFFF lets the driver choose.
+	 */
+	inline void setMaxShaderCompilerThreads(const GLuint count) noexcept
+	{
+		if (detail::g_glMaxShaderCompilerThreads)
+			detail::g_glMaxShaderCompilerThreads(count);
+	}
+
+	/**
+	 * @brief Compiles and links many programs concurrently. Every compile and link is kicked off as soon as its program
+	 * is added, without waiting on any status, so the driver can work through them in the background (in parallel
+	 * with GL_KHR_parallel_shader_compile) while the caller does other work, e.g. drawing a loading screen.
+	 *
+	 * @code
+	 * gal::ProgramBatch batch;
+	 * for (const auto& variant : variants)
+	 *     batch.add(variant.stages, variant.defines);
+	 * while (batch.poll() > 0)
+	 *     drawLoadingScreen(batch.getFinishedCount(), batch.getSize());
+	 * for (std::size_t i = 0; i < batch.getSize(); ++i)
+	 *     if (batch.failed(i))
+	 *         reportError(i, batch.getError(i));
+	 * @endcode
+	 *
+	 * A program that fails to compile or link doesn't stop the others: it's marked finished and failed, with its error
+	 * kept for getError(), and poll() and waitAll() carry on with the rest.
+	 */
+	class ProgramBatch
+	{
+	public:
+		/**
+		 * @brief Create an empty batch.
+		 * @param shaderCache Cache to share identical shaders between programs through, or nullptr to compile every
+		 * stage of every program separately. Must outlive the batch.
+		 */
+		explicit ProgramBatch(ShaderCache* shaderCache = nullptr) noexcept : m_shaderCache(shaderCache) { }
+
+		/**
+		 * @brief Add a program to the batch, starting compilation of all its stages and linking it.
+		 * @param stages Source of every stage of the program.
+		 * @param defines Defines injected after the #version directive of every stage.
+		 * @param binaryRetrievable Whether the program's binary will be retrieved once it's linked, e.g. to store it
+		 * in a ProgramBinaryCache.
+		 * @return Index of the program in the batch.
+		 * @throws ErrCode::CreateProgramFailed If creating the program fails.
+		 * @throws ErrCode::CreateShaderFailed If creating a shader fails.
+		 */
+		std::size_t add(const std::vector<ShaderStageSource>& stages, const std::vector<std::string>& defines = {},
+			const bool binaryRetrievable = false)
+		{
+			Entry& entry = m_entries.emplace_back();
+			entry.shaders.reserve(stages.size());
+			if (binaryRetrievable)
+				entry.program.setBinaryRetrievable();
+
+			for (const auto& stage : stages)
+			{
+				if (m_shaderCache)
+					entry.shaders.push_back(m_shaderCache->acquire(stage.type, stage.source, defines));
+				else
+				{
+					auto shader = std::make_shared<Shader>(stage.type);
+					shader->sourceString(detail::injectDefines(stage.source, defines));
+					shader->compileAsync();
+					entry.shaders.push_back(std::move(shader));
+				}
+
+				entry.program.attachShader(*entry.shaders.back());
+			}
+
+			entry.program.linkAsync();
+			return m_entries.size() - 1;
+		}
+
+		/**
+		 * @brief Get the number of programs in the batch.
+		 */
+		[[nodiscard]] std::size_t getSize() const noexcept { return m_entries.size(); }
+		/**
+		 * @brief Get the number of programs that have finished compiling and linking, including failed ones.
+		 */
+		[[nodiscard]] std::size_t getFinishedCount() const noexcept { return m_finishedCount; }
+		/**
+		 * @brief Get the number of finished programs that failed to compile or link.
+		 */
+		[[nodiscard]] std::size_t getFailedCount() const noexcept { return m_failedCount; }
+
+		/**
+		 * @brief Check whether a program has finished compiling and linking, without blocking.
+		 * @param index Index of the program, as returned by add().
+		 */
+		[[nodiscard]] bool isReady(const std::size_t index) const noexcept
+		{
+			const Entry& entry = m_entries[index];
+			return entry.finished || entry.program.isReady();
+		}
+
+		/**
+		 * @brief Check whether a finished program failed to compile or link.
+		 * @param index Index of the program, as returned by add().
+		 */
+		[[nodiscard]] bool failed(const std::size_t index) const noexcept { return m_entries[index].failed; }
+
+		/**
+		 * @brief Get the error message of a program that failed to compile or link.
+		 * @param index Index of the program, as returned by add().
+		 * @return The message of the failure, or an empty string if the program hasn't failed.
+		 */
+		[[nodiscard]] const std::string& getError(const std::size_t index) const noexcept
+		{
+			return m_entries[index].error;
+		}
+		/**
+		 * @brief Get the error code of a program that failed: ErrCode::ShaderCompilationFailed or
+		 * ErrCode::ProgramLinkFailed. Only meaningful if failed() returns true.
+		 * @param index Index of the program, as returned by add().
+		 */
+		[[nodiscard]] ErrCode getErrorCode(const std::size_t index) const noexcept { return m_entries[index].errCode; }
+
+		/**
+		 * @brief Finish every program whose link has completed, without blocking on any others. Programs that failed
+		 * are marked as such rather than throwing; see failed().
+		 * @return The number of programs still compiling or linking.
+		 */
+		std::size_t poll()
+		{
+			for (auto& entry : m_entries)
+				if (!entry.finished && entry.program.isReady())
+					finish(entry);
+
+			return m_entries.size() - m_finishedCount;
+		}
+
+		/**
+		 * @brief Block until every program in the batch has finished compiling and linking. Programs that failed are
+		 * marked as such rather than throwing; see failed() and getFailedCount().
+		 */
+		void waitAll()
+		{
+			for (auto& entry : m_entries)
+				if (!entry.finished)
+					finish(entry);
+		}
+
+		/**
+		 * @brief Get a program in the batch. Only usable once it's finished, i.e., after isReady() returned true and
+		 * poll() was called, or after waitAll(). References are invalidated by add().
+		 * @param index Index of the program, as returned by add().
+		 */
+		[[nodiscard]] Program& getProgram(const std::size_t index) noexcept { return m_entries[index].program; }
+		/**
+		 * @brief Get a program in the batch. Only usable once it's finished, i.e., after isReady() returned true and
+		 * poll() was called, or after waitAll(). References are invalidated by add().
+		 * @param index Index of the program, as returned by add().
+		 */
+		[[nodiscard]] const Program& getProgram(const std::size_t index) const noexcept { return m_entries[index].program; }
+
+	private:
+		struct Entry
+		{
+			Program program;
+			// Kept until the program is finished so a failed compile can be reported with the shader's own error log,
+			// and so a ShaderCache keeps them alive for other programs in the meantime.
+			std::vector<std::shared_ptr<const Shader>> shaders;
+			bool finished = false;
+			bool failed = false;
+			ErrCode errCode = ErrCode::ProgramLinkFailed;
+			std::string error;
+		};
+
+		ShaderCache* m_shaderCache;
+		std::vector<Entry> m_entries;
+		std::size_t m_finishedCount = 0;
+		std::size_t m_failedCount = 0;
+
+		void finish(Entry& entry)
+		{
+			try
+			{
+				for (const auto& shader : entry.shaders)
+					shader->finishCompile();
+
+				entry.program.finishLink();
+			}
+			catch (const GALException& e)
+			{
+				entry.failed = true;
+				entry.errCode = e.errCode;
+				entry.error = e.what();
+				++m_failedCount;
+			}
+
+			entry.shaders.clear();
+			entry.finished = true;
+			++m_finishedCount;
+		}
+	};
+}
+
+#endif //GAL_PROGRAM_BATCH_HPP
@@ -0,0 +1,344 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_PROGRAM_BINARY_CACHE_HPP
+#define GAL_PROGRAM_BINARY_CACHE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "Program.hpp"
+#include "Shader.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief The source of one stage of a program.
+	 */
+	struct ShaderStageSource
+	{
+		ShaderType type;
+		std::string source;
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Header written in front of every binary in a ProgramBinaryCache directory.
+		 */
+		struct ProgramBinaryFileHeader
+		{
+			char magic[4];
+			std::uint32_t version;
+			std::uint64_t key;
+			std::uint32_t format;
+			std::uint32_t size;
+		};
+
+		constexpr char PROGRAM_BINARY_MAGIC[4] = {'G', 'A', 'L', 'B'};
+		constexpr std::uint32_t PROGRAM_BINARY_VERSION = 1;
+
+		/**
+		 * @brief Get a string identifying the current driver, so binaries from other drivers are never loaded.
+		 */
+		inline std::string getDriverString()
+		{
+			std::string driver;
+			for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+			{
+				if (const GLubyte* str = glGetString(name))
+					driver += reinterpret_cast<const char*>(str);
+				driver += '\n';
+			}
+
+			return driver;
+		}
+
+		/**
+		 * @brief Prepend #define directives to a shader source, after its #version directive.
+		 */
+		inline std::string injectDefines(const std::string& source, const std::vector<std::string>& defines)
+		{
+			if (defines.empty())
+				return source;
+
+			std::string snippet;
+			for (const auto& define : defines)
+			{
+				snippet += "#define ";
+				snippet += define;
+				snippet += '\n';
+			}
+
+			return insertAfterVersionDirective(source, snippet);
+		}
+
+		/**
+		 * @brief Compile every stage from source and link them into a program.
+		 */
+		inline void compileAndLink(const Program& program, const std::vector<ShaderStageSource>& stages,
+			const std::vector<std::string>& defines)
+		{
+			for (const auto& stage : stages)
+			{
+				// Attached shaders outlive their Shader objects until the program is linked and detaches them.
+				const Shader shader{stage.type};
+				shader.sourceString(injectDefines(stage.source, defines));
+				shader.compile();
+				program.attachShader(shader);
+			}
+
+			program.link();
+		}
+	}
+
+	/**
+	 * @brief Compile and link a program from the sources of its stages.
+	 * @param stages Source of every stage of the program.
+	 * @param defines Defines injected after the #version directive of every stage.
+	 * @return The linked program.
+	 * @throws ErrCode::CreateProgramFailed If creating the program fails.
+	 * @throws ErrCode::CreateShaderFailed If creating a shader fails.
+	 * @throws ErrCode::ShaderCompilationFailed If compiling a stage fails.
+	 * @throws ErrCode::ProgramLinkFailed If linking the program fails.
+	 */
+	[[nodiscard]] inline Program buildProgram(const std::vector<ShaderStageSource>& stages,
+		const std::vector<std::string>& defines = {})
+	{
+		Program program;
+		detail::compileAndLink(program, stages, defines);
+		return program;
+	}
+
+	/**
+	 * @brief Caches linked program binaries on disk so programs only have to be compiled from source the first time
+	 * they're built with a given driver.
+	 *
+	 * Binaries are keyed by a hash of every stage's source, the defines they're built with and the driver's vendor,
+	 * renderer and version strings, so editing a shader or updating the driver never loads a stale binary. Drivers
+	 * may still reject a binary, in which case the program is compiled from source and the binary replaced.
+	 */
+	class ProgramBinaryCache
+	{
+	public:
+		/**
+		 * @brief Create a cache storing binaries in the given directory, creating it if needed. An OpenGL context must
+		 * be current.
+		 * @param directory Directory to store binaries in.
+		 */
+		explicit ProgramBinaryCache(std::filesystem::path directory)
+			: m_directory(std::move(directory)), m_driverHash(detail::fnv1a(detail::getDriverString()))
+		{
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			m_supported = formatCount > 0;
+
+			if (!m_supported)
+			{
+				detail::logWarn("Driver supports no program binary formats. Programs will always be compiled from source.");
+				return;
+			}
+
+			std::error_code error;
+			std::filesystem::create_directories(m_directory, error);
+			if (error)
+			{
+				detail::logWarnStart() << "Failed to create program binary cache directory \"" << m_directory.string() <<
+					"\". Programs will always be compiled from source." << detail::logWarnEnd;
+				m_supported = false;
+			}
+		}
+
+		/**
+		 * @brief Get the directory binaries are stored in.
+		 */
+		[[nodiscard]] const std::filesystem::path& getDirectory() const noexcept { return m_directory; }
+		/**
+		 * @brief Check whether binaries can be cached at all. If not, build() always compiles from source.
+		 */
+		[[nodiscard]] bool isSupported() const noexcept { return m_supported; }
+
+		/**
+		 * @brief Get the number of programs loaded from a cached binary.
+		 */
+		[[nodiscard]] std::size_t getHits() const noexcept { return m_hits; }
+		/**
+		 * @brief Get the number of programs that had no cached binary.
+		 */
+		[[nodiscard]] std::size_t getMisses() const noexcept { return m_misses; }
+		/**
+		 * @brief Get the number of cached binaries the driver rejected.
+		 */
+		[[nodiscard]] std::size_t getRejections() const noexcept { return m_rejections; }
+
+		/**
+		 * @brief Compute the key a program built from the given stages and defines is cached under.
+		 * @param stages Source of every stage of the program.
+		 * @param defines Defines injected into every stage.
+		 * @return The key.
+		 */
+		[[nodiscard]] std::uint64_t computeKey(const std::vector<ShaderStageSource>& stages,
+			const std::vector<std::string>& defines = {}) const noexcept
+		{
+			std::uint64_t hash = m_driverHash;
+			for (const auto& stage : stages)
+			{
+				const auto type = static_cast<GLenum>(stage.type);
+				hash = detail::fnv1a({reinterpret_cast<const char*>(&type), sizeof(type)}, hash);
+				hash = detail::fnv1a(stage.source, hash);
+				hash = detail::fnv1a({"\0", 1}, hash);
+			}
+
+			for (const auto& define : defines)
+			{
+				hash = detail::fnv1a(define, hash);
+				hash = detail::fnv1a({"\0", 1}, hash);
+			}
+
+			return hash;
+		}
+
+		/**
+		 * @brief Try to link a program from its cached binary.
+		 * @param program The program to link.
+		 * @param key Key the binary is cached under, from computeKey().
+		 * @return True if the program was linked. False if there's no cached binary or the driver rejected it, in
+		 * which case the program must be linked from source.
+		 */
+		bool load(const Program& program, const std::uint64_t key)
+		{
+			if (!m_supported)
+				return false;
+
+			std::ifstream file{pathFor(key), std::ios::binary};
+			detail::ProgramBinaryFileHeader header{};
+			if (!file.is_open() || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+				std::memcmp(header.magic, detail::PROGRAM_BINARY_MAGIC, sizeof(header.magic)) != 0 ||
+				header.version != detail::PROGRAM_BINARY_VERSION || header.key != key)
+			{
+				++m_misses;
+				return false;
+			}
+
+			std::vector<std::byte> data(header.size);
+			if (!file.read(reinterpret_cast<char*>(data.data()), header.size))
+			{
+				++m_misses;
+				return false;
+			}
+
+			if (!program.loadBinary(header.format, data.data(), static_cast<GLsizei>(header.size)))
+			{
+				++m_rejections;
+				std::error_code error;
+				std::filesystem::remove(pathFor(key), error);
+				return false;
+			}
+
+			++m_hits;
+			return true;
+		}
+
+		/**
+		 * @brief Store a linked program's binary. The program should have been made retrievable with
+		 * Program::setBinaryRetrievable() before linking.
+		 * @param program The linked program.
+		 * @param key Key to cache the binary under, from computeKey().
+		 */
+		void store(const Program& program, const std::uint64_t key) const
+		{
+			if (!m_supported)
+				return;
+
+			const ProgramBinary binary = program.getBinary();
+			if (binary.data.empty())
+			{
+				detail::logWarnStart() << "Driver provided no binary for program ID " << program.getID() << "." <<
+					detail::logWarnEnd;
+				return;
+			}
+
+			detail::ProgramBinaryFileHeader header{};
+			std::memcpy(header.magic, detail::PROGRAM_BINARY_MAGIC, sizeof(header.magic));
+			header.version = detail::PROGRAM_BINARY_VERSION;
+			header.key = key;
+			header.format = binary.format;
+			header.size = static_cast<std::uint32_t>(binary.data.size());
+
+			// Write to a temporary file and rename it into place, so another process never reads a partial binary.
+			const std::filesystem::path path = pathFor(key);
+			std::filesystem::path tempPath = path;
+			tempPath += ".tmp";
+
+			{
+				std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+				if (!file.is_open() ||
+					!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+					!file.write(reinterpret_cast<const char*>(binary.data.data()), header.size))
+				{
+					detail::logWarnStart() << "Failed to write program binary \"" << tempPath.string() << "\"." <<
+						detail::logWarnEnd;
+					return;
+				}
+			}
+
+			std::error_code error;
+			std::filesystem::rename(tempPath, path, error);
+			if (error)
+				std::filesystem::remove(tempPath, error);
+		}
+
+		/**
+		 * @brief Build a program, loading it from its cached binary if possible and otherwise compiling and linking it
+		 * from source and caching the result.
+		 * @param stages Source of every stage of the program.
+		 * @param defines Defines injected after the #version directive of every stage (e.g., "USE_SHADOWS" or
+		 * "MAX_LIGHTS 8").
+		 * @return The linked program.
+		 * @throws ErrCode::CreateProgramFailed If creating the program fails.
+		 * @throws ErrCode::CreateShaderFailed If creating a shader fails.
+		 * @throws ErrCode::ShaderCompilationFailed If compiling a stage fails.
+		 * @throws ErrCode::ProgramLinkFailed If linking the program fails.
+		 */
+		[[nodiscard]] Program build(const std::vector<ShaderStageSource>& stages,
+			const std::vector<std::string>& defines = {})
+		{
+			Program program;
+			const std::uint64_t key = computeKey(stages, defines);
+			if (load(program, key))
+				return program;
+
+			program.setBinaryRetrievable();
+			detail::compileAndLink(program, stages, defines);
+			store(program, key);
+			return program;
+		}
+
+	private:
+		std::filesystem::path m_directory;
+		std::uint64_t m_driverHash;
+		bool m_supported = false;
+
+		std::size_t m_hits = 0;
+		std::size_t m_misses = 0;
+		std::size_t m_rejections = 0;
+
+		[[nodiscard]] std::filesystem::path pathFor(const std::uint64_t key) const
+		{
+			constexpr char digits[] = "0123456789abcdef";
+			std::string name(16, '0');
+			for (int i = 0; i < 16; ++i)
+				name[15 - i] = digits[key >> i * 4 & 0xF];
+
+			return m_directory / (name + ".bin");
+		}
+	};
+}
+
+#endif //GAL_PROGRAM_BINARY_CACHE_HPP
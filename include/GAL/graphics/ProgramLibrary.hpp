@@ -0,0 +1,314 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_PROGRAM_LIBRARY_HPP
+#define GAL_PROGRAM_LIBRARY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Program.hpp"
+#include "ProgramBatch.hpp"
+#include "ProgramBinaryCache.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief Bitmask of the keywords a ProgramLibrary variant is compiled with. Bit i is set if the library's ith
+	 * keyword is defined.
+	 */
+	using KeywordMask = std::uint64_t;
+
+	/**
+	 * @brief A program described as a set of stage sources plus up to 64 keywords, each of which is #defined or not
+	 * in a given variant. Variants are compiled the first time they're requested and kept in a least recently used
+	 * cache of configurable capacity, instead of compiling every combination of keywords up front.
+	 *
+	 * @code
+	 * gal::ProgramLibrary lit{stages, {"USE_SHADOWS", "USE_NORMAL_MAP", "USE_FOG"}, 64};
+	 * const gal::KeywordMask mask = lit.getKeywordMask({"USE_SHADOWS", "USE_FOG"});
+	 * lit.get(mask).use();
+	 * @endcode
+	 */
+	class ProgramLibrary
+	{
+	public:
+		/**
+		 * @brief Create a program library. No variants are compiled until they're requested or pre-warmed.
+		 * @param stages Source of every stage of the program.
+		 * @param keywords Keywords variants may define, at most 64.
+		 * @param capacity Maximum number of compiled variants kept at once, or 0 for no limit.
+		 * @param binaryCache Binary cache to build variants through, or nullptr to always compile from source. Must
+		 * outlive the library.
+		 * @throws ErrCode::TooManyProgramKeywords If more than 64 keywords are given.
+		 */
+		ProgramLibrary(std::vector<ShaderStageSource> stages, std::vector<std::string> keywords,
+			const std::size_t capacity = 0, ProgramBinaryCache* binaryCache = nullptr)
+			: m_stages(std::move(stages)), m_keywords(std::move(keywords)), m_capacity(capacity),
+			m_binaryCache(binaryCache)
+		{
+			if (m_keywords.size() > 64)
+				detail::throwErr(ErrCode::TooManyProgramKeywords, "Program libraries support at most 64 keywords.");
+
+			m_validMask = m_keywords.size() == 64 ? ~KeywordMask{0} : (KeywordMask{1} << m_keywords.size()) - 1;
+		}
+
+		/**
+		 * @brief Get the bit of a keyword.
+		 * @param keyword The keyword.
+		 * @return The keyword's bit, or 0 if the library has no such keyword.
+		 */
+		[[nodiscard]] KeywordMask getKeywordMask(const std::string_view keyword) const noexcept
+		{
+			for (std::size_t i = 0; i < m_keywords.size(); ++i)
+				if (m_keywords[i] == keyword)
+					return KeywordMask{1} << i;
+
+			detail::logWarnStart() << "Program library has no keyword \"" << keyword << "\"." << detail::logWarnEnd;
+			return 0;
+		}
+
+		/**
+		 * @brief Get the mask of several keywords. Resolve masks ahead of time rather than on the hot path.
+		 * @param keywords The keywords.
+		 * @return The union of the keywords' bits. Unknown keywords are ignored.
+		 */
+		[[nodiscard]] KeywordMask getKeywordMask(const std::initializer_list<std::string_view> keywords) const noexcept
+		{
+			KeywordMask mask = 0;
+			for (const auto keyword : keywords)
+				mask |= getKeywordMask(keyword);
+			return mask;
+		}
+
+		/**
+		 * @brief Get a variant, compiling it if it isn't cached. A cached variant is found with a single hash lookup.
+		 * @param mask Keywords the variant defines. Bits not belonging to any keyword are ignored.
+		 * @return The variant. The reference stays valid until the variant is evicted, i.e., until at least capacity
+		 * other variants have been requested since.
+		 * @throws ErrCode::ShaderCompilationFailed If compiling the variant fails.
+		 * @throws ErrCode::ProgramLinkFailed If linking the variant fails.
+		 */
+		[[nodiscard]] const Program& get(KeywordMask mask)
+		{
+			mask &= m_validMask;
+
+			if (!m_variants.empty() && m_variants.front().mask == mask)
+			{
+				++m_hits;
+				return m_variants.front().program;
+			}
+
+			if (const auto it = m_lookup.find(mask); it != m_lookup.end())
+			{
+				++m_hits;
+				m_variants.splice(m_variants.begin(), m_variants, it->second);
+				return it->second->program;
+			}
+
+			++m_misses;
+			detail::logInfoStart() << "Compiling program library variant " << mask << "..." << detail::logInfoEnd;
+			return insert(mask, m_binaryCache ? m_binaryCache->build(m_stages, getDefines(mask)) :
+				buildProgram(m_stages, getDefines(mask)));
+		}
+
+		/**
+		 * @brief Check whether a variant is currently compiled and cached.
+		 * @param mask Keywords the variant defines.
+		 */
+		[[nodiscard]] bool isCached(const KeywordMask mask) const noexcept
+		{
+			return m_lookup.count(mask & m_validMask) != 0;
+		}
+
+		/**
+		 * @brief Compile every variant in a usage list that isn't cached yet, all in parallel. With a
+		 * ProgramBinaryCache, variants with a cached binary are loaded from it instead, and only the rest are compiled.
+		 * Variants later in the list are the first to be evicted if they don't all fit.
+		 * @param masks Usage list of variants, e.g. one saved from getUsageList() in an earlier run.
+		 * @throws ErrCode::ShaderCompilationFailed If compiling a variant fails. Variants that compiled are still cached.
+		 * @throws ErrCode::ProgramLinkFailed If linking a variant fails.
+		 */
+		void prewarm(const std::vector<KeywordMask>& masks)
+		{
+			std::vector<KeywordMask> missing;
+			for (const KeywordMask requested : masks)
+			{
+				const KeywordMask mask = requested & m_validMask;
+				if (!isCached(mask) && std::find(missing.begin(), missing.end(), mask) == missing.end())
+					missing.push_back(mask);
+			}
+
+			if (m_capacity != 0 && missing.size() > m_capacity)
+				missing.resize(m_capacity);
+
+			// Inserted back to front so the first variant in the list ends up most recently used.
+			std::reverse(missing.begin(), missing.end());
+
+			detail::logInfoStart() << "Pre-warming " << missing.size() << " program library variants..." <<
+				detail::logInfoEnd;
+
+			// Variants with a cached binary load right away; the rest are compiled together. Either way, each variant
+			// remembers where its program is, so they're all inserted in list order.
+			struct Pending
+			{
+				bool compiled;
+				std::size_t index;
+				std::uint64_t key;
+			};
+
+			std::vector<Pending> pending;
+			pending.reserve(missing.size());
+			std::vector<Program> loaded;
+			ProgramBatch batch;
+			for (const KeywordMask mask : missing)
+			{
+				const std::vector<std::string> defines = getDefines(mask);
+				std::uint64_t key = 0;
+				if (m_binaryCache)
+				{
+					Program program;
+					key = m_binaryCache->computeKey(m_stages, defines);
+					if (m_binaryCache->load(program, key))
+					{
+						pending.push_back({false, loaded.size(), key});
+						loaded.push_back(std::move(program));
+						continue;
+					}
+				}
+
+				pending.push_back({true, batch.add(m_stages, defines, m_binaryCache != nullptr), key});
+			}
+
+			batch.waitAll();
+			for (std::size_t i = 0; i < missing.size(); ++i)
+			{
+				if (!pending[i].compiled)
+					insert(missing[i], std::move(loaded[pending[i].index]));
+				else if (!batch.failed(pending[i].index))
+				{
+					if (m_binaryCache)
+						m_binaryCache->store(batch.getProgram(pending[i].index), pending[i].key);
+					insert(missing[i], std::move(batch.getProgram(pending[i].index)));
+				}
+			}
+
+			m_misses += missing.size();
+
+			// Variants that compiled stay cached; every failure was already logged when it happened.
+			for (std::size_t i = 0; i < batch.getSize(); ++i)
+				if (batch.failed(i))
+					throw GALException(batch.getErrorCode(i), batch.getError(i).c_str());
+		}
+
+		/**
+		 * @brief Get every cached variant, most recently used first, to be saved and passed to prewarm() next run.
+		 */
+		[[nodiscard]] std::vector<KeywordMask> getUsageList() const
+		{
+			std::vector<KeywordMask> masks;
+			masks.reserve(m_variants.size());
+			for (const auto& variant : m_variants)
+				masks.push_back(variant.mask);
+			return masks;
+		}
+
+		/**
+		 * @brief Get the #defines a variant is compiled with.
+		 * @param mask Keywords the variant defines.
+		 */
+		[[nodiscard]] std::vector<std::string> getDefines(const KeywordMask mask) const
+		{
+			std::vector<std::string> defines;
+			for (std::size_t i = 0; i < m_keywords.size(); ++i)
+				if (mask >> i & 1)
+					defines.push_back(m_keywords[i]);
+			return defines;
+		}
+
+		/**
+		 * @brief Get the keywords of the library, in bit order.
+		 */
+		[[nodiscard]] const std::vector<std::string>& getKeywords() const noexcept { return m_keywords; }
+		/**
+		 * @brief Get the number of variants currently cached.
+		 */
+		[[nodiscard]] std::size_t getSize() const noexcept { return m_variants.size(); }
+		/**
+		 * @brief Get the maximum number of variants cached at once, or 0 if there's no limit.
+		 */
+		[[nodiscard]] std::size_t getCapacity() const noexcept { return m_capacity; }
+		/**
+		 * @brief Set the maximum number of variants cached at once, evicting least recently used variants as needed.
+		 * @param capacity The new capacity, or 0 for no limit.
+		 */
+		void setCapacity(const std::size_t capacity)
+		{
+			m_capacity = capacity;
+			evict();
+		}
+
+		/**
+		 * @brief Get the number of requests answered by a cached variant.
+		 */
+		[[nodiscard]] std::size_t getHits() const noexcept { return m_hits; }
+		/**
+		 * @brief Get the number of variants compiled, including pre-warmed ones.
+		 */
+		[[nodiscard]] std::size_t getMisses() const noexcept { return m_misses; }
+		/**
+		 * @brief Get the number of variants evicted to stay within capacity.
+		 */
+		[[nodiscard]] std::size_t getEvictions() const noexcept { return m_evictions; }
+
+	private:
+		struct Variant
+		{
+			KeywordMask mask;
+			Program program;
+		};
+
+		std::vector<ShaderStageSource> m_stages;
+		std::vector<std::string> m_keywords;
+		KeywordMask m_validMask = 0;
+		std::size_t m_capacity;
+		ProgramBinaryCache* m_binaryCache;
+
+		// Most recently used first. List nodes never move, so references to programs stay valid until evicted.
+		std::list<Variant> m_variants;
+		std::unordered_map<KeywordMask, std::list<Variant>::iterator> m_lookup;
+
+		std::size_t m_hits = 0;
+		std::size_t m_misses = 0;
+		std::size_t m_evictions = 0;
+
+		const Program& insert(const KeywordMask mask, Program&& program)
+		{
+			m_variants.push_front({mask, std::move(program)});
+			m_lookup[mask] = m_variants.begin();
+			evict();
+			return m_variants.front().program;
+		}
+
+		void evict()
+		{
+			while (m_capacity != 0 && m_variants.size() > m_capacity)
+			{
+				detail::logInfoStart() << "Evicting program library variant " << m_variants.back().mask << "." <<
+					detail::logInfoEnd;
+				m_lookup.erase(m_variants.back().mask);
+				m_variants.pop_back();
+				++m_evictions;
+			}
+		}
+	};
+}
+
+#endif //GAL_PROGRAM_LIBRARY_HPP
@@ -0,0 +1,142 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_PROGRAM_PIPELINE_HPP
+#define GAL_PROGRAM_PIPELINE_HPP
+
+#include <vector>
+
+#include "Program.hpp"
+
+namespace gal
+{
+	namespace detail
+	{
+		inline void programPipelineDeleter(const ProgramPipelineID id) noexcept
+		{
+			glDeleteProgramPipelines(1, &id);
+		}
+
+		using UniqueProgramPipeline = UniqueHandle<ProgramPipelineID, 0, &programPipelineDeleter>;
+	}
+
+	/**
+	 * @brief Wrapper around an OpenGL program pipeline, which combines the stages of separately linked programs (see
+	 * Program::setSeparable()). Swapping the program a stage comes from costs no linking, so N vertex programs and M
+	 * fragment programs can be combined in every way with only N + M links.
+	 *
+	 * Uniforms are still set on each stage's own Program, since its setters never depend on which program is bound.
+	 */
+	class ProgramPipeline : detail::UniqueProgramPipeline
+	{
+	public:
+		/**
+		 * @brief Create an empty program pipeline.
+		 * @throws ErrCode::CreateProgramPipelineFailed If program pipeline creation fails.
+		 */
+		ProgramPipeline()
+		{
+			detail::logInfo("Creating program pipeline...");
+			detail::logIncreaseIndent();
+
+			ProgramPipelineID id;
+			glCreateProgramPipelines(1, &id);
+			if (!id)
+				detail::throwErr(ErrCode::CreateProgramPipelineFailed, "Failed to create program pipeline.");
+			detail::logInfoStart() << "Successfully created program pipeline ID " << id << "." << detail::logInfoEnd;
+
+			setHandle(id);
+			detail::logInfo("Successfully created program pipeline.");
+			detail::logDecreaseIndent();
+		}
+
+		/**
+		 * @brief Get the ID of the program pipeline.
+		 * @return The ID (name) of the program pipeline in OpenGL.
+		 */
+		[[nodiscard]] ProgramPipelineID getID() const noexcept { return getHandle(); }
+
+		/**
+		 * @brief Make OpenGL draw with the program pipeline. Also unbinds any program bound with Program::use(), which
+		 * would otherwise take precedence over the pipeline.
+		 */
+		void bind() const noexcept
+		{
+			detail::useProgram(0);
+			glBindProgramPipeline(getHandle());
+		}
+
+		/**
+		 * @brief Use the given stages of a separable program in the pipeline. Stages the program doesn't contain are
+		 * removed from the pipeline.
+		 * @param program The linked separable program.
+		 * @param stages The stages to take from the program.
+		 */
+		void useProgramStages(const Program& program, const ProgramStage stages) const noexcept
+		{
+			glUseProgramStages(getHandle(), static_cast<GLbitfield>(stages), program.getID());
+		}
+
+		/**
+		 * @brief Remove the given stages from the pipeline.
+		 * @param stages The stages to remove.
+		 */
+		void clearProgramStages(const ProgramStage stages) const noexcept
+		{
+			glUseProgramStages(getHandle(), static_cast<GLbitfield>(stages), 0);
+		}
+
+		/**
+		 * @brief Get the ID of the program the given stage currently comes from.
+		 * @param stage The shader stage.
+		 * @return The program's ID, or 0 if the stage is empty.
+		 */
+		[[nodiscard]] ProgramID getStageProgram(const ShaderType stage) const noexcept
+		{
+			GLint program;
+			glGetProgramPipelineiv(getHandle(), static_cast<GLenum>(stage), &program);
+			return static_cast<ProgramID>(program);
+		}
+
+		/**
+		 * @brief Set the program that non-DSA uniform calls (glUniform*()) apply to while the pipeline is bound. GAL's
+		 * own uniform setters don't need this.
+		 * @param program The program.
+		 */
+		void setActiveProgram(const Program& program) const noexcept
+		{
+			glActiveShaderProgram(getHandle(), program.getID());
+		}
+
+		/**
+		 * @brief Check that the pipeline's stages fit together and can be drawn with in the current state, e.g. that
+		 * the outputs of each stage match the inputs of the next.
+		 * @return True if the pipeline is valid. If not, and GAL_WARNING_LOGGING is defined, OpenGL's log of why is
+		 * printed to the console.
+		 */
+		[[nodiscard]] bool validate() const
+		{
+			glValidateProgramPipeline(getHandle());
+
+			GLint valid;
+			glGetProgramPipelineiv(getHandle(), GL_VALIDATE_STATUS, &valid);
+			if (valid)
+				return true;
+
+#ifdef GAL_WARNING_LOGGING
+			GLint logLength = 0;
+			glGetProgramPipelineiv(getHandle(), GL_INFO_LOG_LENGTH, &logLength);
+
+			std::vector<GLchar> log(logLength > 0 ? logLength : 1, '\0');
+			glGetProgramPipelineInfoLog(getHandle(), logLength, nullptr, log.data());
+
+			detail::logWarnStart() << "Program pipeline ID " << getHandle() << " failed validation:\n" << log.data() <<
+				detail::logWarnEnd;
+#endif
+			return false;
+		}
+	};
+}
+
+#endif //GAL_PROGRAM_PIPELINE_HPP
@@ -0,0 +1,191 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_PROGRAM_REFLECTION_HPP
+#define GAL_PROGRAM_REFLECTION_HPP
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "UniformLocation.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief An active uniform or shader storage block member (buffer variable) of a linked program, as reflected at
+	 * link time.
+	 */
+	struct UniformInfo
+	{
+		std::uint64_t hash;
+		/// Name as reported by OpenGL. Arrays of basic types are reported once, as "name[0]".
+		std::string name;
+		/// GLSL type (e.g., GL_FLOAT_VEC3).
+		GLenum type;
+		/// Number of array elements, or 1 if the uniform isn't an array.
+		GLint arraySize;
+		/// Location of the uniform, or -1 if it's a member of a block.
+		GLint location;
+		/// Index of the block the uniform is a member of, or -1 if it isn't one.
+		GLint blockIndex;
+		/// Byte offset of the uniform within its block, or -1 if it isn't in one.
+		GLint offset;
+		/// Distance between array elements within its block, 0 if it isn't an array, or -1 if it isn't in a block.
+		GLint arrayStride;
+		/// Distance between matrix columns within its block, 0 if it isn't a matrix, or -1 if it isn't in a block.
+		GLint matrixStride;
+	};
+
+	/**
+	 * @brief An active uniform block or shader storage block of a linked program, as reflected at link time.
+	 */
+	struct BlockInfo
+	{
+		std::uint64_t hash;
+		std::string name;
+		/// Index of the block within the program.
+		GLuint index;
+		/// Buffer binding index the block is currently assigned to.
+		GLint binding;
+		/// Minimum size of the buffer backing the block, in bytes.
+		GLint dataSize;
+	};
+
+	/**
+	 * @brief Everything reflected from a program at link time, with each table sorted by name hash.
+	 */
+	struct ProgramReflection
+	{
+		std::vector<UniformInfo> uniforms;
+		std::vector<BlockInfo> uniformBlocks;
+		std::vector<BlockInfo> storageBlocks;
+		/// Members of shader storage blocks. Their block indices refer to storageBlocks.
+		std::vector<UniformInfo> bufferVariables;
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Find an entry in a table sorted by hash.
+		 * @return A pointer to the entry, or nullptr if there's none with the given name.
+		 */
+		template<typename Entry>
+		const Entry* findByName(const std::vector<Entry>& table, const UniformName& name) noexcept
+		{
+			auto it = std::lower_bound(table.begin(), table.end(), name.getHash(),
+				[](const Entry& entry, const std::uint64_t hash) { return entry.hash < hash; });
+
+			for (; it != table.end() && it->hash == name.getHash(); ++it)
+				if (it->name == name.getName())
+					return &*it;
+
+			return nullptr;
+		}
+
+		template<typename Entry>
+		Entry* findByName(std::vector<Entry>& table, const UniformName& name) noexcept
+		{
+			return const_cast<Entry*>(findByName(std::as_const(table), name));
+		}
+
+		template<typename Entry>
+		void sortByHash(std::vector<Entry>& table)
+		{
+			std::sort(table.begin(), table.end(), [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+		}
+
+		/**
+		 * @brief Get the name of a program resource.
+		 */
+		inline std::string getProgramResourceName(const ProgramID program, const GLenum interface, const GLuint index,
+			const GLint nameLength)
+		{
+			std::string name(nameLength, '\0');
+			GLsizei written = 0;
+			glGetProgramResourceName(program, interface, index, nameLength, &written, name.data());
+			name.resize(written);
+			return name;
+		}
+
+		/**
+		 * @brief Reflect all uniform blocks or shader storage blocks of a program.
+		 */
+		inline std::vector<BlockInfo> reflectBlocks(const ProgramID program, const GLenum interface)
+		{
+			GLint count = 0;
+			glGetProgramInterfaceiv(program, interface, GL_ACTIVE_RESOURCES, &count);
+
+			std::vector<BlockInfo> blocks;
+			blocks.reserve(count);
+
+			constexpr GLenum props[] = {GL_NAME_LENGTH, GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE};
+			for (GLint i = 0; i < count; ++i)
+			{
+				GLint values[3];
+				glGetProgramResourceiv(program, interface, i, 3, props, 3, nullptr, values);
+
+				std::string name = getProgramResourceName(program, interface, i, values[0]);
+				const std::uint64_t hash = fnv1a(name);
+				blocks.push_back({hash, std::move(name), static_cast<GLuint>(i), values[1], values[2]});
+			}
+
+			sortByHash(blocks);
+			return blocks;
+		}
+
+		/**
+		 * @brief Reflect all active uniforms or buffer variables of a program.
+		 */
+		inline std::vector<UniformInfo> reflectVariables(const ProgramID program, const GLenum interface)
+		{
+			GLint count = 0;
+			glGetProgramInterfaceiv(program, interface, GL_ACTIVE_RESOURCES, &count);
+
+			std::vector<UniformInfo> variables;
+			variables.reserve(count);
+
+			// Buffer variables have no location, so it's only queried for uniforms.
+			constexpr GLenum props[] = {GL_NAME_LENGTH, GL_TYPE, GL_ARRAY_SIZE, GL_BLOCK_INDEX, GL_OFFSET,
+				GL_ARRAY_STRIDE, GL_MATRIX_STRIDE, GL_LOCATION};
+			const GLsizei propCount = interface == GL_UNIFORM ? 8 : 7;
+			for (GLint i = 0; i < count; ++i)
+			{
+				GLint values[8] = {0, 0, 0, 0, 0, 0, 0, -1};
+				glGetProgramResourceiv(program, interface, i, propCount, props, propCount, nullptr, values);
+
+				std::string name = getProgramResourceName(program, interface, i, values[0]);
+				const std::uint64_t hash = fnv1a(name);
+				const bool inBlock = values[3] != -1;
+				variables.push_back({hash, std::move(name), static_cast<GLenum>(values[1]), values[2], values[7],
+					values[3], inBlock ? values[4] : -1, inBlock ? values[5] : -1, inBlock ? values[6] : -1});
+			}
+
+			sortByHash(variables);
+			return variables;
+		}
+
+		/**
+		 * @brief Reflect all active uniforms, uniform blocks, shader storage blocks and their members of a linked
+		 * program.
+		 */
+		inline ProgramReflection reflectProgram(const ProgramID program)
+		{
+			ProgramReflection reflection;
+			reflection.uniforms = reflectVariables(program, GL_UNIFORM);
+			reflection.uniformBlocks = reflectBlocks(program, GL_UNIFORM_BLOCK);
+			reflection.storageBlocks = reflectBlocks(program, GL_SHADER_STORAGE_BLOCK);
+			reflection.bufferVariables = reflectVariables(program, GL_BUFFER_VARIABLE);
+
+			logInfoStart() << "Reflected " << reflection.uniforms.size() << " uniforms, " <<
+				reflection.uniformBlocks.size() << " uniform blocks and " << reflection.storageBlocks.size() <<
+				" storage blocks from program ID " << program << "." << logInfoEnd;
+
+			return reflection;
+		}
+	}
+}
+
+#endif //GAL_PROGRAM_REFLECTION_HPP
@@ -0,0 +1,340 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_RENDER_QUEUE_HPP
+#define GAL_RENDER_QUEUE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "IndexBuffer.hpp"
+#include "Program.hpp"
+#include "UniformRing.hpp"
+#include "VertexArray.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief Build the 64-bit key draws are sorted by in a RenderQueue. From most to least significant: pass (4 bits),
+	 * program (12 bits), material (16 bits) and depth (32 bits), so draws are grouped by pass, then by program, then by
+	 * material, and ordered by depth within a material.
+	 * @param pass Render pass, e.g. 0 for opaque and 1 for transparent. Only the low 4 bits are used.
+	 * @param program Sort index of the program, e.g. its ID. Only the low 12 bits are used.
+	 * @param material Sort index of the material, i.e., of the textures and constants the draw shares with others.
+	 * @param depth Depth bits from depthSortBits().
+	 */
+	[[nodiscard]] constexpr std::uint64_t makeSortKey(const std::uint32_t pass, const std::uint32_t program,
+		const std::uint32_t material, const std::uint32_t depth) noexcept
+	{
+		return std::uint64_t{pass & 0xFu} << 60 | std::uint64_t{program & 0xFFFu} << 48 |
+			std::uint64_t{material & 0xFFFFu} << 32 | depth;
+	}
+
+	/**
+	 * @brief Convert a view depth to bits that sort in depth order as unsigned integers.
+	 * @param depth View depth. Any float, including negative ones.
+	 * @param backToFront Whether farther draws should sort first, e.g. for transparent passes.
+	 */
+	[[nodiscard]] inline std::uint32_t depthSortBits(const float depth, const bool backToFront = false) noexcept
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &depth, sizeof(bits));
+		// Flip every bit of negative floats and only the sign bit of positive ones, which orders them as integers.
+		bits ^= bits >> 31 ? 0xFFFFFFFFu : 0x80000000u;
+		return backToFront ? ~bits : bits;
+	}
+
+	/**
+	 * @brief A compact record of everything one draw needs: the state to bind and the draw call's parameters.
+	 */
+	struct DrawPacket
+	{
+		/// Key the draw is sorted by. See makeSortKey().
+		std::uint64_t key = 0;
+
+		ProgramID program = 0;
+		VertexArrayID vertexArray = 0;
+		/// Textures bound to units 0 to 3. 0 leaves a unit empty.
+		std::array<TextureID, 4> textures{};
+
+		/// Slice of a uniform buffer holding the draw's constants, e.g. from UniformRing::push(), or a buffer of 0 for
+		/// none.
+		BufferID uniformBuffer = 0;
+		GLuint uniformBinding = 0;
+		GLintptr uniformOffset = 0;
+		GLsizeiptr uniformSize = 0;
+
+		DrawMode mode = DrawMode::Triangles;
+		/// Whether the draw reads indices from the vertex array's element buffer.
+		bool indexed = false;
+		IndexType indexType = IndexType::UnsignedInt;
+		bool primitiveRestart = false;
+		/// Number of vertices or indices.
+		GLsizei count = 0;
+		/// First vertex, or first index if the draw is indexed.
+		GLuint first = 0;
+		GLint baseVertex = 0;
+		GLsizei instanceCount = 1;
+		GLuint baseInstance = 0;
+
+		/**
+		 * @brief Set the slice of a UniformRing holding the draw's constants.
+		 * @param ring The ring the slice was allocated from.
+		 * @param binding Uniform buffer binding index of the block that reads the constants.
+		 * @param slice The slice.
+		 * @return Reference to this packet for chaining.
+		 */
+		DrawPacket& setUniforms(const UniformRing& ring, const GLuint binding, const UniformSlice& slice) noexcept
+		{
+			uniformBuffer = ring.getBuffer().getID();
+			uniformBinding = binding;
+			uniformOffset = slice.offset;
+			uniformSize = slice.size;
+			return *this;
+		}
+	};
+
+	/**
+	 * @brief Counts of the state changes a RenderQueue made submitting its draws, along with how many submitting them
+	 * in the order they were pushed would have made.
+	 */
+	struct RenderQueueStats
+	{
+		std::size_t draws = 0;
+		std::size_t programChanges = 0;
+		std::size_t vertexArrayChanges = 0;
+		std::size_t textureChanges = 0;
+		std::size_t uniformBufferChanges = 0;
+		/// Total state changes made submitting in sorted order.
+		std::size_t stateChanges = 0;
+		/// Total state changes submitting in push order would have made.
+		std::size_t unsortedStateChanges = 0;
+	};
+
+	/**
+	 * @brief Records draws as compact packets, sorts them by a 64-bit key with a radix sort, and submits them with
+	 * only the state changes needed between consecutive draws, so programs, vertex arrays and textures don't thrash
+	 * when the scene is traversed in an order unrelated to its state.
+	 *
+	 * @code
+	 * queue.clear();
+	 * for (const auto& object : scene)
+	 *     queue.push(gal::makeSortKey(0, object.program->getID(), object.materialID, gal::depthSortBits(object.depth)),
+	 *         *object.program, *object.vertexArray, *object.indexBuffer).setUniforms(ring, 0, ring.push(object.constants));
+	 * queue.sort();
+	 * queue.execute();
+	 * @endcode
+	 */
+	class RenderQueue
+	{
+	public:
+		/**
+		 * @brief Remove every draw, e.g. at the start of a frame. Keeps the allocated memory.
+		 */
+		void clear() noexcept
+		{
+			m_packets.clear();
+			m_order.clear();
+		}
+
+		/**
+		 * @brief Add a draw.
+		 * @param packet The draw.
+		 * @return Reference to the stored packet, valid until the next push.
+		 */
+		DrawPacket& push(const DrawPacket& packet)
+		{
+			m_order.push_back({packet.key, static_cast<std::uint32_t>(m_packets.size())});
+			return m_packets.emplace_back(packet);
+		}
+
+		/**
+		 * @brief Add an indexed draw of a whole index buffer.
+		 * @param key Sort key. See makeSortKey().
+		 * @param program The program to draw with.
+		 * @param vertexArray The vertex array to draw, with indexBuffer as its element buffer.
+		 * @param indexBuffer The index buffer.
+		 * @param instanceCount Number of instances to draw.
+		 * @return Reference to the stored packet, e.g. to set its textures or uniforms, valid until the next push.
+		 */
+		DrawPacket& push(const std::uint64_t key, const Program& program, const VertexArray& vertexArray,
+			const IndexBuffer& indexBuffer, const GLsizei instanceCount = 1)
+		{
+			DrawPacket packet;
+			packet.key = key;
+			packet.program = program.getID();
+			packet.vertexArray = vertexArray.getID();
+			packet.mode = indexBuffer.getDrawMode();
+			packet.indexed = true;
+			packet.indexType = indexBuffer.getIndexType();
+			packet.primitiveRestart = indexBuffer.usesPrimitiveRestart();
+			packet.count = indexBuffer.getCount();
+			packet.instanceCount = instanceCount;
+			return push(packet);
+		}
+
+		/**
+		 * @brief Get the number of draws in the queue.
+		 */
+		[[nodiscard]] std::size_t getSize() const noexcept { return m_packets.size(); }
+
+		/**
+		 * @brief Sort the draws by key. Draws with equal keys keep the order they were pushed in.
+		 */
+		void sort()
+		{
+			if (m_order.size() < 2)
+				return;
+			m_scratch.resize(m_order.size());
+
+			// LSD radix sort, 8 bits at a time, skipping digits every key has in common (e.g. unused pass bits).
+			for (int shift = 0; shift < 64; shift += 8)
+			{
+				std::array<std::size_t, 256> offsets{};
+				for (const SortEntry& entry : m_order)
+					++offsets[entry.key >> shift & 0xFF];
+
+				if (offsets[m_order.front().key >> shift & 0xFF] == m_order.size())
+					continue;
+
+				std::size_t sum = 0;
+				for (std::size_t& offset : offsets)
+				{
+					const std::size_t count = offset;
+					offset = sum;
+					sum += count;
+				}
+
+				for (const SortEntry& entry : m_order)
+					m_scratch[offsets[entry.key >> shift & 0xFF]++] = entry;
+				m_order.swap(m_scratch);
+			}
+		}
+
+		/**
+		 * @brief Submit every draw in the current order (sorted, if sort() was called), changing only the state that
+		 * differs from the previous draw. Binds go through the current context's GLStateCache, so state left bound by
+		 * the previous frame isn't rebound either. Leaves the last draw's state bound.
+		 * @return Counts of the state changes made, and of those submitting in push order would have made.
+		 */
+		RenderQueueStats execute()
+		{
+			RenderQueueStats stats;
+			stats.draws = m_packets.size();
+
+			// Count the changes push order would make without issuing them, for comparison.
+			State unsorted;
+			RenderQueueStats unsortedStats;
+			for (const DrawPacket& packet : m_packets)
+				applyState(packet, unsorted, unsortedStats, false);
+			stats.unsortedStateChanges = unsortedStats.stateChanges;
+
+			State current;
+			for (const SortEntry& entry : m_order)
+			{
+				const DrawPacket& packet = m_packets[entry.index];
+				applyState(packet, current, stats, true);
+				draw(packet);
+			}
+
+			return stats;
+		}
+
+	private:
+		struct SortEntry
+		{
+			std::uint64_t key;
+			std::uint32_t index;
+		};
+
+		struct State
+		{
+			ProgramID program = 0;
+			VertexArrayID vertexArray = 0;
+			std::array<TextureID, 4> textures{};
+			BufferID uniformBuffer = 0;
+			GLuint uniformBinding = 0;
+			GLintptr uniformOffset = 0;
+			GLsizeiptr uniformSize = 0;
+			// Unknown until the first draw sets it.
+			int primitiveRestart = -1;
+		};
+
+		std::vector<DrawPacket> m_packets;
+		std::vector<SortEntry> m_order;
+		std::vector<SortEntry> m_scratch;
+
+		static void applyState(const DrawPacket& packet, State& state, RenderQueueStats& stats, const bool issue)
+		{
+			if (packet.program != state.program)
+			{
+				if (issue)
+					detail::useProgram(packet.program);
+				state.program = packet.program;
+				++stats.programChanges;
+				++stats.stateChanges;
+			}
+
+			if (packet.vertexArray != state.vertexArray)
+			{
+				if (issue)
+					detail::bindVertexArray(packet.vertexArray);
+				state.vertexArray = packet.vertexArray;
+				++stats.vertexArrayChanges;
+				++stats.stateChanges;
+			}
+
+			if (packet.textures != state.textures)
+			{
+				if (issue)
+					detail::bindTextures(0, static_cast<GLsizei>(packet.textures.size()), packet.textures.data());
+				state.textures = packet.textures;
+				++stats.textureChanges;
+				++stats.stateChanges;
+			}
+
+			if (packet.uniformBuffer && (packet.uniformBuffer != state.uniformBuffer ||
+				packet.uniformBinding != state.uniformBinding || packet.uniformOffset != state.uniformOffset ||
+				packet.uniformSize != state.uniformSize))
+			{
+				if (issue)
+					detail::bindBufferRange(GL_UNIFORM_BUFFER, packet.uniformBinding, packet.uniformBuffer,
+						packet.uniformOffset, packet.uniformSize);
+				state.uniformBuffer = packet.uniformBuffer;
+				state.uniformBinding = packet.uniformBinding;
+				state.uniformOffset = packet.uniformOffset;
+				state.uniformSize = packet.uniformSize;
+				++stats.uniformBufferChanges;
+				++stats.stateChanges;
+			}
+
+			if (packet.indexed && packet.primitiveRestart != state.primitiveRestart)
+			{
+				if (issue)
+					detail::setPrimitiveRestart(packet.primitiveRestart);
+				state.primitiveRestart = packet.primitiveRestart;
+				++stats.stateChanges;
+			}
+		}
+
+		static void draw(const DrawPacket& packet) noexcept
+		{
+			if (packet.indexed)
+			{
+				const auto offset = static_cast<std::uintptr_t>(packet.first) *
+					static_cast<std::uintptr_t>(indexTypeSize(packet.indexType));
+				glDrawElementsInstancedBaseVertexBaseInstance(static_cast<GLenum>(packet.mode), packet.count,
+					static_cast<GLenum>(packet.indexType), reinterpret_cast<const void*>(offset), packet.instanceCount,
+					packet.baseVertex, packet.baseInstance);
+			}
+			else
+				glDrawArraysInstancedBaseInstance(static_cast<GLenum>(packet.mode), static_cast<GLint>(packet.first),
+					packet.count, packet.instanceCount, packet.baseInstance);
+		}
+	};
+}
+
+#endif //GAL_RENDER_QUEUE_HPP
@@ -4,7 +4,17 @@
 
 #ifndef GAL_SHADER_HPP
 #define GAL_SHADER_HPP
-#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "ShaderFileLoader.hpp"
+#include "ShaderPreprocessor.hpp"
 
 namespace gal
 {
@@ -16,8 +26,119 @@ namespace gal
 		}
 
 		using UniqueShader = UniqueHandle<ShaderID, 0, shaderDeleter>;
+
+		/**
+		 * @brief Insert a snippet of GLSL directly after the #version directive of a shader source, or at the very
+		 * beginning if it has none.
+		 */
+		inline std::string insertAfterVersionDirective(const std::string& source, const std::string& snippet)
+		{
+			const std::size_t versionPos = source.find("#version");
+			if (versionPos == std::string::npos)
+				return snippet + source;
+
+			std::size_t lineEnd = source.find('\n', versionPos);
+			lineEnd = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+
+			std::string result;
+			result.reserve(source.size() + snippet.size() + 1);
+			result.append(source, 0, lineEnd);
+			if (lineEnd == source.size())
+				result += '\n';
+			result += snippet;
+			result.append(source, lineEnd, std::string::npos);
+			return result;
+		}
+
+		/**
+		 * @brief Insert a snippet of GLSL declarations after the leading #version and #extension directives of a
+		 * shader source, since #extension has to come before anything that isn't a preprocessor directive. A #line
+		 * directive follows the snippet, so compile errors still report the source's own line numbers.
+		 */
+		inline std::string insertAfterLeadingDirectives(const std::string& source, const std::string& snippet)
+		{
+			std::size_t insertPos = 0;
+			std::size_t lineStart = 0;
+			std::size_t lineNumber = 1;
+			std::size_t insertLine = 1;
+			bool inComment = false;
+
+			while (lineStart < source.size())
+			{
+				std::size_t lineEnd = source.find('\n', lineStart);
+				lineEnd = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+				std::string_view line{source.data() + lineStart, lineEnd - lineStart};
+				line.remove_prefix(std::min(line.find_first_not_of(" \t\r\n"), line.size()));
+
+				// Blank lines and comments may sit between the directives; anything else ends them.
+				if (inComment)
+					inComment = line.find("*/") == std::string_view::npos;
+				else if (line.substr(0, 2) == "/*")
+					inComment = line.find("*/", 2) == std::string_view::npos;
+				else if (line.substr(0, 8) == "#version" || line.substr(0, 10) == "#extension")
+				{
+					insertPos = lineEnd;
+					insertLine = lineNumber + 1;
+				}
+				else if (!line.empty() && line.substr(0, 2) != "//")
+					break;
+
+				lineStart = lineEnd;
+				++lineNumber;
+			}
+
+			std::string result;
+			result.reserve(source.size() + snippet.size() + 16);
+			result.append(source, 0, insertPos);
+			if (insertPos > 0 && source[insertPos - 1] != '\n')
+				result += '\n';
+			result += snippet;
+			if (!snippet.empty() && snippet.back() != '\n')
+				result += '\n';
+			result += "#line " + std::to_string(insertLine) + '\n';
+			result.append(source, insertPos, std::string::npos);
+			return result;
+		}
 	}
 
+	/**
+	 * @brief Check whether the driver accepts SPIR-V shader binaries (GL_ARB_gl_spirv, core in OpenGL 4.6), i.e.,
+	 * whether Shader::sourceSPIRV() can be used.
+	 */
+	[[nodiscard]] inline bool isSPIRVSupported()
+	{
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &formatCount);
+		if (formatCount <= 0)
+			return false;
+
+		std::vector<GLint> formats(formatCount);
+		glGetIntegerv(GL_SHADER_BINARY_FORMATS, formats.data());
+		for (const GLint format : formats)
+			if (format == GL_SHADER_BINARY_FORMAT_SPIR_V)
+				return true;
+		return false;
+	}
+
+	/**
+	 * @brief The value of a SPIR-V specialization constant, by constant ID (the SpecId decoration, or
+	 * layout(constant_id = ...) in GLSL). Scalars of any type are stored as their raw 32-bit pattern.
+	 */
+	struct SpecializationConstant
+	{
+		GLuint index;
+		GLuint value;
+
+		SpecializationConstant(const GLuint index, const GLuint value) noexcept : index(index), value(value) { }
+		SpecializationConstant(const GLuint index, const GLint value) noexcept
+			: index(index), value(static_cast<GLuint>(value)) { }
+		SpecializationConstant(const GLuint index, const bool value) noexcept : index(index), value(value) { }
+		SpecializationConstant(const GLuint index, const GLfloat value) noexcept : index(index), value(0)
+		{
+			std::memcpy(&this->value, &value, sizeof(value));
+		}
+	};
+
 	/**
 	 * @brief Wrapper around an OpenGL shader.
 	 */
@@ -59,28 +180,167 @@ namespace gal
 		{
 			const char* sourceChars = source.c_str();
 			glShaderSource(getHandle(), 1, &sourceChars, nullptr);
+			m_spirv = false;
+		}
+
+		/**
+		 * @brief Set the shader's source from a string view, which doesn't need to be null-terminated.
+		 * @param source View of the shader's source code.
+		 */
+		void sourceView(const std::string_view source) const noexcept
+		{
+			const char* sourceChars = source.data();
+			const auto length = static_cast<GLint>(source.size());
+			glShaderSource(getHandle(), 1, &sourceChars, &length);
+			m_spirv = false;
 		}
 
 		/**
-		 * @brief Set the shader's source from a file.
+		 * @brief Set the shader's source from several strings, which OpenGL treats as if they were concatenated.
+		 * @param count Number of strings.
+		 * @param strings Pointers to the strings.
+		 * @param lengths Length of each string, or nullptr if they're all null-terminated.
+		 */
+		void sourceStrings(const GLsizei count, const char* const* strings, const GLint* lengths) const noexcept
+		{
+			glShaderSource(getHandle(), count, strings, lengths);
+			m_spirv = false;
+		}
+
+		/**
+		 * @brief Set the shader's source from the output of a ShaderPreprocessor. Each piece is passed to OpenGL as a
+		 * separate string, so the resolved source is never copied into one.
+		 * @param source The preprocessed source.
+		 */
+		void sourcePreprocessed(const PreprocessedSource& source) const noexcept
+		{
+			sourceStrings(source.getCount(), source.strings.data(), source.lengths.data());
+		}
+
+		/**
+		 * @brief Set the shader's source from a file loaded with loadShaderFiles(). The file's contents are passed to
+		 * OpenGL directly, without being copied.
+		 * @param file The loaded file.
+		 */
+		void sourceMapped(const MappedFile& file) const noexcept
+		{
+			sourceView(file.getView());
+		}
+
+		/**
+		 * @brief Set the shader's source to a SPIR-V module, skipping GLSL parsing at runtime. Afterwards, specialize()
+		 * the shader instead of compiling it (compile() specializes the "main" entry point with default constants).
+		 * Check isSPIRVSupported() first.
+		 * @param code The SPIR-V words.
+		 * @param wordCount Number of 32-bit words.
+		 */
+		void sourceSPIRV(const std::uint32_t* code, const std::size_t wordCount) const noexcept
+		{
+			const ShaderID id = getHandle();
+			glShaderBinary(1, &id, GL_SHADER_BINARY_FORMAT_SPIR_V, code,
+				static_cast<GLsizei>(wordCount * sizeof(std::uint32_t)));
+			m_spirv = true;
+		}
+
+		/**
+		 * @brief Set the shader's source to a SPIR-V module, skipping GLSL parsing at runtime.
+		 * @tparam Container Container type. This can be anything that has a .data() and .size() method and stores
+		 * std::uint32_t words contiguously in memory (e.g., std::array, std::vector, etc.).
+		 * @param code The container with the SPIR-V words.
+		 */
+		template<typename Container>
+		auto sourceSPIRV(const Container& code) const noexcept
+			-> std::enable_if_t<
+				std::is_same_v<std::remove_cv_t<std::remove_pointer_t<decltype(code.data())>>, std::uint32_t> &&
+				std::is_integral_v<decltype(code.size())>
+			>
+		{
+			sourceSPIRV(code.data(), code.size());
+		}
+
+		/**
+		 * @brief Set the shader's source to a SPIR-V module loaded with loadShaderFiles(), e.g. a .spv file.
+		 * @param file The loaded file.
+		 */
+		void sourceSPIRV(const MappedFile& file) const noexcept
+		{
+			const ShaderID id = getHandle();
+			glShaderBinary(1, &id, GL_SHADER_BINARY_FORMAT_SPIR_V, file.getData(), static_cast<GLsizei>(file.getSize()));
+			m_spirv = true;
+		}
+
+		/**
+		 * @brief Check whether the shader's source was last set with sourceSPIRV() rather than from GLSL.
+		 */
+		[[nodiscard]] bool isSPIRV() const noexcept { return m_spirv; }
+
+		/**
+		 * @brief Specialize a SPIR-V shader, which takes the place of compiling it: picks the entry point and sets
+		 * specialization constants, so one module can stand in for many define-based variants.
+		 * @param entryPoint Name of the entry point in the module.
+		 * @param constants Values of specialization constants. Constants not listed keep their defaults.
+		 * @throws ErrCode::ShaderCompilationFailed If specialization fails, e.g. if the entry point or a constant ID
+		 * doesn't exist. If GAL_ERROR_LOGGING is defined, the error printed to the console will contain OpenGL's error
+		 * log.
+		 */
+		void specialize(const char* entryPoint = "main",
+			const std::initializer_list<SpecializationConstant> constants = {}) const
+		{
+			specialize(entryPoint, constants.begin(), constants.size());
+		}
+
+		/**
+		 * @brief Specialize a SPIR-V shader, which takes the place of compiling it.
+		 * @param entryPoint Name of the entry point in the module.
+		 * @param constants Values of specialization constants. Constants not listed keep their defaults.
+		 * @throws ErrCode::ShaderCompilationFailed If specialization fails.
+		 */
+		void specialize(const char* entryPoint, const std::vector<SpecializationConstant>& constants) const
+		{
+			specialize(entryPoint, constants.data(), constants.size());
+		}
+
+		/**
+		 * @brief Specialize a SPIR-V shader, which takes the place of compiling it.
+		 * @param entryPoint Name of the entry point in the module.
+		 * @param constants Pointer to the values of specialization constants.
+		 * @param count Number of constants.
+		 * @throws ErrCode::ShaderCompilationFailed If specialization fails.
+		 */
+		void specialize(const char* entryPoint, const SpecializationConstant* constants, const std::size_t count) const
+		{
+			detail::logInfoStart() << "Specializing shader ID " << getHandle() << " at entry point \"" << entryPoint <<
+				"\" with " << count << " constants..." << detail::logInfoEnd;
+			detail::logIncreaseIndent();
+
+			std::vector<GLuint> indices(count);
+			std::vector<GLuint> values(count);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				indices[i] = constants[i].index;
+				values[i] = constants[i].value;
+			}
+
+			glSpecializeShader(getHandle(), entryPoint, static_cast<GLuint>(count), indices.data(), values.data());
+			finishCompile();
+
+			detail::logDecreaseIndent();
+		}
+
+		/**
+		 * @brief Set the shader's source from a file. To load many files, use loadShaderFiles() and sourceMapped()
+		 * instead, which read them in parallel.
 		 * @param path Filepath to the file containing the shader's source code.
 		 * @throws ErrCode::ShaderFileReadFailed If reading the file at the path provided fails for any reason.
 		 */
 		void sourceFile(const std::string& path) const
 		{
-			std::ifstream file{path};
-			if (!file.is_open())
-				detail::throwErr(ErrCode::ShaderFileReadFailed, "Failed to read shader source file.");
-
-			std::stringstream buffer;
-			buffer << file.rdbuf();
-
-			sourceString(buffer.str());
+			sourceMapped(MappedFile{path});
 		}
 
 		/**
 		 * @brief Compile the shader with the source code provided with an earlier call to sourceString() or
-		 * sourceFile().
+		 * sourceFile(). A SPIR-V shader is specialized at its "main" entry point with default constants instead.
 		 * @throws ErrCode::ShaderCompilationFailed If shader compilation fails for any reason. If GAL_ERROR_LOGGING is
 		 * defined, the error printed to the console will contain OpenGL's error log with reasons why compilation failed.
 		 */
@@ -89,16 +349,59 @@ namespace gal
 			detail::logInfoStart() << "Compiling shader ID " << getHandle() << "..." << detail::logInfoEnd;
 			detail::logIncreaseIndent();
 
-			glCompileShader(getHandle());
+			compileAsync();
+			finishCompile();
+
+			detail::logDecreaseIndent();
+		}
+
+		/**
+		 * @brief Start compiling the shader without waiting for the result. Poll isReady() and call finishCompile()
+		 * once it returns true, or call finishCompile() directly to wait. A SPIR-V shader is specialized at its "main"
+		 * entry point with default constants instead.
+		 */
+		void compileAsync() const noexcept
+		{
+			if (m_spirv)
+				glSpecializeShader(getHandle(), "main", 0, nullptr, nullptr);
+			else
+				glCompileShader(getHandle());
+		}
 
+		/**
+		 * @brief Check whether a compile started with compileAsync() has finished, without blocking. Always true if the
+		 * driver doesn't support GL_KHR_parallel_shader_compile, in which case finishCompile() may block.
+		 */
+		[[nodiscard]] bool isReady() const noexcept
+		{
+			if (!detail::g_parallelShaderCompileSupported)
+				return true;
+
+			GLint ready;
+			glGetShaderiv(getHandle(), GL_COMPLETION_STATUS_KHR, &ready);
+			return ready;
+		}
+
+		/**
+		 * @brief Wait for a compile started with compileAsync() to finish and check that it succeeded. Also checks
+		 * the result of specializing a SPIR-V shader.
+		 * @throws ErrCode::ShaderCompilationFailed If shader compilation fails for any reason. If GAL_ERROR_LOGGING is
+		 * defined, the error printed to the console will contain OpenGL's error log with reasons why compilation failed.
+		 */
+		void finishCompile() const
+		{
 			GLint success;
 			glGetShaderiv(getHandle(), GL_COMPILE_STATUS, &success);
 			if (!success)
 			{
 #ifdef GAL_ERROR_LOGGING
-				GLint logLength;
+				GLint logLength = 0;
 				glGetShaderiv(getHandle(), GL_INFO_LOG_LENGTH, &logLength);
 
+				// Drivers may give no log at all, e.g. when a SPIR-V shader fails to specialize.
+				if (logLength <= 0)
+					detail::throwErr(ErrCode::ShaderCompilationFailed, "Failed to compile shader. OpenGL gave no error log.");
+
 				std::vector<GLchar> errorLog(logLength);
 				glGetShaderInfoLog(getHandle(), logLength, &logLength, errorLog.data());
 
@@ -109,8 +412,7 @@ namespace gal
 #endif
 			}
 
-			detail::logInfo("Successfully compiled shader.");
-			detail::logDecreaseIndent();
+			detail::logInfoStart() << "Successfully compiled shader ID " << getHandle() << "." << detail::logInfoEnd;
 		}
 
 		/**
@@ -120,6 +422,9 @@ namespace gal
 		 * is here as a more explicit option that's less ugly than calling the destructor directly.
 		 */
 		void destroy() const noexcept { this->~Shader(); }
+
+	private:
+		mutable bool m_spirv = false;
 	};
 }
 
@@ -0,0 +1,190 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_SHADER_CACHE_HPP
+#define GAL_SHADER_CACHE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Program.hpp"
+#include "ProgramBinaryCache.hpp"
+#include "Shader.hpp"
+#include "ShaderPreprocessor.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief Deduplicates shader objects by content, so programs built from identical stage sources and defines share
+	 * a single compiled shader instead of each compiling their own.
+	 *
+	 * Shaders are handed out as shared pointers and the cache only holds weak references to them, so a shader is
+	 * deleted as soon as no program waiting to be linked holds it anymore. Identical sources requested after that are
+	 * compiled again.
+	 */
+	class ShaderCache
+	{
+	public:
+		/**
+		 * @brief Get a shader compiled from the given source and defines, reusing a live one if there is one.
+		 * Compilation of a new shader is only started, not waited on: check it with Shader::finishCompile() (or just
+		 * link a program with it, which fails if it didn't compile).
+		 * @param type Type of the shader.
+		 * @param source Source of the shader.
+		 * @param defines Defines injected after the #version directive.
+		 * @return The shader. Keep it alive until every program it's attached to is linked.
+		 * @throws ErrCode::CreateShaderFailed If creating a new shader fails.
+		 */
+		[[nodiscard]] std::shared_ptr<const Shader> acquire(const ShaderType type, const std::string& source,
+			const std::vector<std::string>& defines = {})
+		{
+			std::uint64_t key = detail::fnv1a(source, typeSeed(type));
+			for (const auto& define : defines)
+				key = detail::fnv1a({"\0", 1}, detail::fnv1a(define, key));
+
+			if (auto shader = find(key))
+				return shader;
+
+			auto shader = std::make_shared<Shader>(type);
+			shader->sourceString(detail::injectDefines(source, defines));
+			return insert(key, std::move(shader));
+		}
+
+		/**
+		 * @brief Get a shader compiled from the given preprocessed source, reusing a live one if there is one.
+		 * Compilation of a new shader is only started, not waited on.
+		 * @param type Type of the shader.
+		 * @param source Output of a ShaderPreprocessor.
+		 * @return The shader. Keep it alive until every program it's attached to is linked.
+		 * @throws ErrCode::CreateShaderFailed If creating a new shader fails.
+		 */
+		[[nodiscard]] std::shared_ptr<const Shader> acquire(const ShaderType type, const PreprocessedSource& source)
+		{
+			const std::uint64_t key = source.hash ^ typeSeed(type);
+			if (auto shader = find(key))
+				return shader;
+
+			auto shader = std::make_shared<Shader>(type);
+			shader->sourcePreprocessed(source);
+			return insert(key, std::move(shader));
+		}
+
+		/**
+		 * @brief Build a program from the sources of its stages, reusing live shaders where possible.
+		 * @param stages Source of every stage of the program.
+		 * @param defines Defines injected after the #version directive of every stage.
+		 * @return The linked program.
+		 * @throws ErrCode::CreateProgramFailed If creating the program fails.
+		 * @throws ErrCode::CreateShaderFailed If creating a shader fails.
+		 * @throws ErrCode::ShaderCompilationFailed If compiling a stage fails.
+		 * @throws ErrCode::ProgramLinkFailed If linking the program fails.
+		 */
+		[[nodiscard]] Program build(const std::vector<ShaderStageSource>& stages,
+			const std::vector<std::string>& defines = {})
+		{
+			Program program;
+
+			std::vector<std::shared_ptr<const Shader>> shaders;
+			shaders.reserve(stages.size());
+			for (const auto& stage : stages)
+				shaders.push_back(acquire(stage.type, stage.source, defines));
+
+			for (const auto& shader : shaders)
+			{
+				shader->finishCompile();
+				program.attachShader(*shader);
+			}
+
+			program.link();
+			return program;
+		}
+
+		/**
+		 * @brief Get the number of requests answered with an already compiled shader.
+		 */
+		[[nodiscard]] std::size_t getHits() const noexcept { return m_hits; }
+		/**
+		 * @brief Get the number of requests that had to compile a new shader.
+		 */
+		[[nodiscard]] std::size_t getMisses() const noexcept { return m_misses; }
+		/**
+		 * @brief Get the fraction of requests answered with an already compiled shader.
+		 */
+		[[nodiscard]] double getHitRate() const noexcept
+		{
+			const std::size_t requests = m_hits + m_misses;
+			return requests ? static_cast<double>(m_hits) / static_cast<double>(requests) : 0.0;
+		}
+		/**
+		 * @brief Reset the counters returned by getHits() and getMisses().
+		 */
+		void resetStats() noexcept
+		{
+			m_hits = 0;
+			m_misses = 0;
+		}
+
+		/**
+		 * @brief Get the number of shaders currently alive in the cache.
+		 */
+		[[nodiscard]] std::size_t getSize()
+		{
+			purge();
+			return m_shaders.size();
+		}
+
+	private:
+		std::unordered_map<std::uint64_t, std::weak_ptr<const Shader>> m_shaders;
+		std::size_t m_hits = 0;
+		std::size_t m_misses = 0;
+		// Expired entries are purged whenever the table has doubled since the last purge.
+		std::size_t m_purgeThreshold = 64;
+
+		static std::uint64_t typeSeed(const ShaderType type) noexcept
+		{
+			const auto glType = static_cast<GLenum>(type);
+			return detail::fnv1a({reinterpret_cast<const char*>(&glType), sizeof(glType)});
+		}
+
+		std::shared_ptr<const Shader> find(const std::uint64_t key)
+		{
+			const auto it = m_shaders.find(key);
+			if (it == m_shaders.end())
+				return nullptr;
+
+			auto shader = it->second.lock();
+			if (shader)
+				++m_hits;
+			return shader;
+		}
+
+		std::shared_ptr<const Shader> insert(const std::uint64_t key, std::shared_ptr<Shader> shader)
+		{
+			++m_misses;
+			shader->compileAsync();
+			m_shaders[key] = shader;
+
+			if (m_shaders.size() >= m_purgeThreshold)
+			{
+				purge();
+				m_purgeThreshold = std::max<std::size_t>(64, m_shaders.size() * 2);
+			}
+
+			return shader;
+		}
+
+		void purge()
+		{
+			for (auto it = m_shaders.begin(); it != m_shaders.end();)
+				it = it->second.expired() ? m_shaders.erase(it) : std::next(it);
+		}
+	};
+}
+
+#endif //GAL_SHADER_CACHE_HPP
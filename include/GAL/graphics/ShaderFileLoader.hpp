@@ -0,0 +1,206 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_SHADER_FILE_LOADER_HPP
+#define GAL_SHADER_FILE_LOADER_HPP
+
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GAL_MAPPED_FILES
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "GAL/detail/parallel.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief A read-only view of a whole file, memory-mapped where the platform supports it and read into memory
+	 * otherwise. The contents are not null-terminated, so pass them to OpenGL with their length (see
+	 * Shader::sourceMapped()).
+	 */
+	class MappedFile
+	{
+	public:
+		/**
+		 * @brief Create an empty file view.
+		 */
+		MappedFile() noexcept = default;
+
+		/**
+		 * @brief Map a file into memory. Its pages are faulted in here, so that reading the contents later, e.g. in
+		 * glShaderSource(), doesn't hit the disk.
+		 * @param path Path to the file.
+		 * @throws ErrCode::ShaderFileReadFailed If the file can't be opened or mapped.
+		 */
+		explicit MappedFile(std::filesystem::path path) : m_path(std::move(path))
+		{
+#ifdef GAL_MAPPED_FILES
+			const int fd = open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+			struct stat status{};
+			if (fd == -1 || fstat(fd, &status) == -1)
+			{
+				if (fd != -1)
+					close(fd);
+				fail();
+				return;
+			}
+
+			m_size = static_cast<std::size_t>(status.st_size);
+			if (m_size > 0)
+			{
+#ifdef MAP_POPULATE
+				constexpr int flags = MAP_PRIVATE | MAP_POPULATE;
+#else
+				constexpr int flags = MAP_PRIVATE;
+#endif
+				void* mapping = mmap(nullptr, m_size, PROT_READ, flags, fd, 0);
+				if (mapping == MAP_FAILED)
+				{
+					close(fd);
+					fail();
+					return;
+				}
+
+				m_data = static_cast<const char*>(mapping);
+#ifndef MAP_POPULATE
+				madvise(mapping, m_size, MADV_WILLNEED);
+#endif
+			}
+			close(fd);
+#else
+			std::ifstream file{m_path, std::ios::binary | std::ios::ate};
+			if (!file.is_open())
+			{
+				fail();
+				return;
+			}
+
+			m_buffer.resize(static_cast<std::size_t>(file.tellg()));
+			file.seekg(0);
+			if (!file.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size())))
+			{
+				fail();
+				return;
+			}
+
+			m_data = m_buffer.data();
+			m_size = m_buffer.size();
+#endif
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+		MappedFile& operator=(MappedFile&& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			unmap();
+			m_path = std::move(other.m_path);
+			m_data = other.m_data;
+			m_size = other.m_size;
+#ifndef GAL_MAPPED_FILES
+			m_buffer = std::move(other.m_buffer);
+			m_data = m_buffer.data();
+#endif
+			other.m_data = nullptr;
+			other.m_size = 0;
+			return *this;
+		}
+
+		~MappedFile() { unmap(); }
+
+		/**
+		 * @brief Get the path the file was loaded from.
+		 */
+		[[nodiscard]] const std::filesystem::path& getPath() const noexcept { return m_path; }
+		/**
+		 * @brief Get a pointer to the file's contents, which are not null-terminated. Never nullptr, even if the file
+		 * is empty.
+		 */
+		[[nodiscard]] const char* getData() const noexcept { return m_data ? m_data : ""; }
+		/**
+		 * @brief Get the size of the file in bytes.
+		 */
+		[[nodiscard]] std::size_t getSize() const noexcept { return m_size; }
+		/**
+		 * @brief Get the file's contents as a string view.
+		 */
+		[[nodiscard]] std::string_view getView() const noexcept { return {getData(), m_size}; }
+
+	private:
+		std::filesystem::path m_path;
+		const char* m_data = nullptr;
+		std::size_t m_size = 0;
+#ifndef GAL_MAPPED_FILES
+		std::string m_buffer;
+#endif
+
+		void fail() const
+		{
+			detail::logErrStart() << "Failed to read shader source file \"" << m_path.string() << "\"." <<
+				detail::logErrEnd;
+			detail::throwErr(ErrCode::ShaderFileReadFailed, "Failed to read shader source file.");
+		}
+
+		void unmap() noexcept
+		{
+#ifdef GAL_MAPPED_FILES
+			if (m_data)
+				munmap(const_cast<char*>(m_data), m_size);
+#endif
+			m_data = nullptr;
+			m_size = 0;
+		}
+	};
+
+	/**
+	 * @brief Map many shader files into memory in parallel, so the file system work of loading them is spread over a
+	 * pool of threads and kept off the thread with the OpenGL context. Hand the results to Shader::sourceMapped(),
+	 * which passes them to OpenGL without copying them.
+	 * @param paths Paths to the files.
+	 * @param threadCount Number of threads to load on, including the calling thread. 0 uses one per hardware thread.
+	 * @return The files, in the same order as their paths.
+	 * @throws ErrCode::ShaderFileReadFailed If any file can't be read.
+	 */
+	inline std::vector<MappedFile> loadShaderFiles(const std::vector<std::filesystem::path>& paths,
+		const unsigned threadCount = 0)
+	{
+		std::vector<MappedFile> files(paths.size());
+		std::vector<std::exception_ptr> errors(paths.size());
+
+		detail::parallelFor(paths.size(), threadCount, [&](const std::size_t i)
+		{
+			try
+			{
+				files[i] = MappedFile{paths[i]};
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception();
+			}
+		});
+
+		for (const auto& error : errors)
+			if (error)
+				std::rethrow_exception(error);
+
+		return files;
+	}
+}
+
+#endif //GAL_SHADER_FILE_LOADER_HPP
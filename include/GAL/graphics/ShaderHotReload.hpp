@@ -0,0 +1,355 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_SHADER_HOT_RELOAD_HPP
+#define GAL_SHADER_HOT_RELOAD_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Program.hpp"
+#include "Shader.hpp"
+#include "ShaderPreprocessor.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief The file one stage of a hot-reloaded program is read from.
+	 */
+	struct ShaderStageFile
+	{
+		ShaderType type;
+		std::filesystem::path path;
+	};
+
+	/**
+	 * @brief Opt-in service that watches the shader files behind programs, and the files they #include, and rebuilds
+	 * the programs when they change.
+	 *
+	 * Changes are picked up by a background thread (with inotify on Linux, by polling modification times elsewhere).
+	 * Rebuilding happens on the thread with the OpenGL context, in update(), which should be called once per frame:
+	 * changed programs are compiled and linked through the non-blocking path, and each one is swapped into the
+	 * Program it was registered with once it's ready. The watched Program object itself is reassigned, so references
+	 * to it stay valid. If a rebuild fails, the error is logged and the old program is kept.
+	 *
+	 * Uniform values don't carry over to the rebuilt program. Set them again in the reload callback if they aren't
+	 * set every frame anyway.
+	 */
+	class ShaderHotReloader
+	{
+	public:
+		using ReloadCallback = std::function<void(const Program&)>;
+
+		/**
+		 * @brief Start watching for changes. Nothing is watched until programs are registered with watch().
+		 * @param includeDirectories Directories to search for files #included by watched shaders.
+		 */
+		explicit ShaderHotReloader(std::vector<std::filesystem::path> includeDirectories = {})
+			: m_preprocessor(std::move(includeDirectories))
+		{
+#ifdef __linux__
+			m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			if (m_inotifyFd == -1)
+				detail::logWarn("Failed to initialize inotify. Falling back to polling shader files for changes.");
+#endif
+			m_thread = std::thread([this] { watchLoop(); });
+			detail::logInfo("Started shader hot reloading.");
+		}
+
+		ShaderHotReloader(const ShaderHotReloader&) = delete;
+		ShaderHotReloader& operator=(const ShaderHotReloader&) = delete;
+
+		~ShaderHotReloader()
+		{
+			m_stop = true;
+			m_thread.join();
+#ifdef __linux__
+			if (m_inotifyFd != -1)
+				close(m_inotifyFd);
+#endif
+		}
+
+		/**
+		 * @brief Watch the files a program is built from. The program isn't rebuilt now; it's expected to already be
+		 * built from the same files.
+		 * @param program The program to rebuild and reassign when its files change. Must outlive the watch, or be
+		 * unwatched with unwatch() before it's destroyed.
+		 * @param stages The file of every stage of the program.
+		 * @param defines Defines injected after the #version directive of every stage.
+		 * @param onReload Called with the program each time it's been swapped for a rebuilt one.
+		 * @throws ErrCode::ShaderFileReadFailed If a file can't be read.
+		 * @throws ErrCode::ShaderIncludeFailed If an #include can't be resolved.
+		 */
+		void watch(Program& program, std::vector<ShaderStageFile> stages, std::vector<std::string> defines = {},
+			ReloadCallback onReload = {})
+		{
+			auto& entry = m_entries.emplace_back(std::make_unique<Entry>());
+			entry->target = &program;
+			entry->stages = std::move(stages);
+			entry->defines = std::move(defines);
+			entry->onReload = std::move(onReload);
+			updateDependencies(*entry);
+		}
+
+		/**
+		 * @brief Stop watching a program.
+		 * @param program The program passed to watch().
+		 */
+		void unwatch(const Program& program)
+		{
+			m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+				[&](const auto& entry) { return entry->target == &program; }), m_entries.end());
+		}
+
+		/**
+		 * @brief Start rebuilding programs whose files changed, and swap in every rebuilt program that's finished
+		 * compiling and linking. Call once per frame, between frames, on the thread with the OpenGL context.
+		 * @return The number of programs swapped.
+		 */
+		std::size_t update()
+		{
+			std::unordered_set<std::string> changed;
+			{
+				const std::lock_guard lock{m_mutex};
+				changed.swap(m_changed);
+			}
+
+			if (!changed.empty())
+				startRebuilds(changed);
+
+			std::size_t swapped = 0;
+			for (auto& entry : m_entries)
+				if (entry->pending && entry->pending->program.isReady())
+					swapped += finishRebuild(*entry);
+
+			return swapped;
+		}
+
+		/**
+		 * @brief Get the number of programs rebuilt and swapped so far.
+		 */
+		[[nodiscard]] std::size_t getReloadCount() const noexcept { return m_reloadCount; }
+		/**
+		 * @brief Get the number of rebuilds that failed and kept the old program.
+		 */
+		[[nodiscard]] std::size_t getFailureCount() const noexcept { return m_failureCount; }
+
+	private:
+		struct Rebuild
+		{
+			Program program;
+			std::vector<Shader> shaders;
+		};
+
+		struct Entry
+		{
+			Program* target = nullptr;
+			std::vector<ShaderStageFile> stages;
+			std::vector<std::string> defines;
+			ReloadCallback onReload;
+			std::vector<std::string> dependencies;
+			std::unique_ptr<Rebuild> pending;
+		};
+
+		ShaderPreprocessor m_preprocessor;
+		std::vector<std::unique_ptr<Entry>> m_entries;
+		std::size_t m_reloadCount = 0;
+		std::size_t m_failureCount = 0;
+
+		// Shared with the watcher thread.
+		std::mutex m_mutex;
+		std::unordered_set<std::string> m_changed;
+		std::unordered_map<std::string, std::filesystem::file_time_type> m_watchedFiles;
+#ifdef __linux__
+		int m_inotifyFd = -1;
+		std::unordered_map<int, std::filesystem::path> m_watchedDirectories;
+#endif
+		std::atomic<bool> m_stop{false};
+		std::thread m_thread;
+
+		/**
+		 * @brief Resolve an entry's stages to find every file it depends on, and watch them.
+		 */
+		void updateDependencies(Entry& entry)
+		{
+			entry.dependencies.clear();
+			for (const auto& stage : entry.stages)
+				for (const auto& file : m_preprocessor.preprocessFile(stage.path, entry.defines).files)
+					entry.dependencies.push_back(file.string());
+
+			const std::lock_guard lock{m_mutex};
+			for (const auto& dependency : entry.dependencies)
+			{
+				if (m_watchedFiles.count(dependency))
+					continue;
+
+				std::error_code error;
+				m_watchedFiles[dependency] = std::filesystem::last_write_time(dependency, error);
+#ifdef __linux__
+				watchDirectory(std::filesystem::path{dependency}.parent_path());
+#endif
+			}
+		}
+
+#ifdef __linux__
+		void watchDirectory(const std::filesystem::path& directory)
+		{
+			if (m_inotifyFd == -1)
+				return;
+
+			// Directories are watched rather than files, since many editors save by replacing the file.
+			const int wd = inotify_add_watch(m_inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+			if (wd == -1)
+				detail::logWarnStart() << "Failed to watch shader directory \"" << directory.string() << "\"." <<
+					detail::logWarnEnd;
+			else
+				m_watchedDirectories[wd] = directory;
+		}
+#endif
+
+		void watchLoop()
+		{
+			while (!m_stop)
+			{
+#ifdef __linux__
+				if (m_inotifyFd != -1)
+				{
+					readInotifyEvents();
+					continue;
+				}
+#endif
+				pollModificationTimes();
+				std::this_thread::sleep_for(std::chrono::milliseconds(250));
+			}
+		}
+
+#ifdef __linux__
+		void readInotifyEvents()
+		{
+			pollfd pollFd{m_inotifyFd, POLLIN, 0};
+			if (poll(&pollFd, 1, 100) <= 0)
+				return;
+
+			alignas(inotify_event) char buffer[4096];
+			const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+
+			const std::lock_guard lock{m_mutex};
+			for (ssize_t offset = 0; offset < length;)
+			{
+				const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+				offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+				const auto directory = m_watchedDirectories.find(event->wd);
+				if (event->len == 0 || directory == m_watchedDirectories.end())
+					continue;
+
+				std::string path = (directory->second / event->name).string();
+				if (m_watchedFiles.count(path))
+					m_changed.insert(std::move(path));
+			}
+		}
+#endif
+
+		void pollModificationTimes()
+		{
+			const std::lock_guard lock{m_mutex};
+			for (auto& [path, lastWriteTime] : m_watchedFiles)
+			{
+				std::error_code error;
+				const auto writeTime = std::filesystem::last_write_time(path, error);
+				if (!error && writeTime != lastWriteTime)
+				{
+					lastWriteTime = writeTime;
+					m_changed.insert(path);
+				}
+			}
+		}
+
+		void startRebuilds(const std::unordered_set<std::string>& changed)
+		{
+			for (const auto& path : changed)
+			{
+				detail::logInfoStart() << "Shader file \"" << path << "\" changed." << detail::logInfoEnd;
+				m_preprocessor.invalidateFile(path);
+			}
+
+			for (auto& entry : m_entries)
+			{
+				const bool affected = std::any_of(entry->dependencies.begin(), entry->dependencies.end(),
+					[&](const std::string& dependency) { return changed.count(dependency) != 0; });
+				if (!affected)
+					continue;
+
+				// Replaces any rebuild still in flight, which is now stale.
+				try
+				{
+					auto rebuild = std::make_unique<Rebuild>();
+					rebuild->shaders.reserve(entry->stages.size());
+					for (const auto& stage : entry->stages)
+					{
+						const Shader& shader = rebuild->shaders.emplace_back(stage.type);
+						shader.sourcePreprocessed(m_preprocessor.preprocessFile(stage.path, entry->defines));
+						shader.compileAsync();
+						rebuild->program.attachShader(shader);
+					}
+
+					if (entry->target->isSeparable())
+						rebuild->program.setSeparable();
+					rebuild->program.linkAsync();
+					entry->pending = std::move(rebuild);
+					updateDependencies(*entry);
+				}
+				catch (const GALException&)
+				{
+					detail::logErr("Failed to start rebuilding a hot-reloaded program. Keeping the old one.");
+					entry->pending.reset();
+					++m_failureCount;
+				}
+			}
+		}
+
+		bool finishRebuild(Entry& entry)
+		{
+			const std::unique_ptr<Rebuild> rebuild = std::move(entry.pending);
+			try
+			{
+				for (const auto& shader : rebuild->shaders)
+					shader.finishCompile();
+				rebuild->program.finishLink();
+			}
+			catch (const GALException&)
+			{
+				detail::logErr("Failed to rebuild a hot-reloaded program. Keeping the old one.");
+				++m_failureCount;
+				return false;
+			}
+
+			*entry.target = std::move(rebuild->program);
+			++m_reloadCount;
+			detail::logInfoStart() << "Hot-reloaded program ID " << entry.target->getID() << "." << detail::logInfoEnd;
+
+			if (entry.onReload)
+				entry.onReload(*entry.target);
+			return true;
+		}
+	};
+}
+
+#endif //GAL_SHADER_HOT_RELOAD_HPP
@@ -0,0 +1,383 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_SHADER_PREPROCESSOR_HPP
+#define GAL_SHADER_PREPROCESSOR_HPP
+
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ShaderFileLoader.hpp"
+#include "UniformLocation.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief A shader source with its #includes resolved and defines injected, held as a list of pieces that are
+	 * passed to glShaderSource() as separate strings instead of being concatenated.
+	 *
+	 * Pieces point into the ShaderPreprocessor's file cache, so a PreprocessedSource is only valid as long as the
+	 * preprocessor that produced it and until the files it includes are invalidated.
+	 *
+	 * #line directives are placed wherever pieces are spliced together, so compiler errors report the line in the file
+	 * it came from. The root source is source string 0, and included files are numbered from 1 in the order they were
+	 * first included.
+	 */
+	struct PreprocessedSource
+	{
+		/// Hash of the full resolved source, i.e., of every piece in order.
+		std::uint64_t hash = 0;
+		std::vector<const char*> strings;
+		std::vector<GLint> lengths;
+		/// Every file the source was resolved from, starting with the root file if there is one.
+		std::vector<std::filesystem::path> files;
+		/// Storage for the injected #define block and #line directives, which the pieces may point into.
+		std::shared_ptr<std::deque<std::string>> directives = std::make_shared<std::deque<std::string>>();
+
+		/**
+		 * @brief Get the number of pieces.
+		 */
+		[[nodiscard]] GLsizei getCount() const noexcept { return static_cast<GLsizei>(strings.size()); }
+
+		/**
+		 * @brief Concatenate every piece, e.g. for logging or for hashing by a shader cache.
+		 */
+		[[nodiscard]] std::string concatenate() const
+		{
+			std::string source;
+			for (std::size_t i = 0; i < strings.size(); ++i)
+				source.append(strings[i], lengths[i]);
+			return source;
+		}
+	};
+
+	/**
+	 * @brief Resolves #include directives in GLSL and injects #define sets directly after the #version directive.
+	 *
+	 * Both #include "file" and #include <file> are supported. Quoted includes are searched for relative to the
+	 * including file first and then in the include directories; angled includes only in the include directories.
+	 * Every file is included at most once per shader, as if it had an include guard, so include cycles are harmless.
+	 *
+	 * Files are memory-mapped once and cached, and resolved sources are cached by the root file and defines they were
+	 * resolved with. Call invalidateFile() when a file changes on disk.
+	 */
+	class ShaderPreprocessor
+	{
+	public:
+		/**
+		 * @brief Create a preprocessor.
+		 * @param includeDirectories Directories to search for included files.
+		 */
+		explicit ShaderPreprocessor(std::vector<std::filesystem::path> includeDirectories = {})
+			: m_includeDirectories(std::move(includeDirectories)) { }
+
+		/**
+		 * @brief Add a directory to search for included files.
+		 */
+		void addIncludeDirectory(std::filesystem::path directory)
+		{
+			m_includeDirectories.push_back(std::move(directory));
+		}
+
+		/**
+		 * @brief Resolve a shader file.
+		 * @param path Path to the shader file.
+		 * @param defines Defines to inject after the #version directive (e.g., "USE_SHADOWS" or "MAX_LIGHTS 8").
+		 * @return The resolved source, cached until a file it includes is invalidated.
+		 * @throws ErrCode::ShaderFileReadFailed If the file or a file it includes can't be read.
+		 * @throws ErrCode::ShaderIncludeFailed If an #include is malformed or the file it names can't be found.
+		 */
+		const PreprocessedSource& preprocessFile(const std::filesystem::path& path,
+			const std::vector<std::string>& defines = {})
+		{
+			const std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(path);
+			return resolve(detail::fnv1a(canonicalPath.string()), defines, [&]
+			{
+				PreprocessedSource source;
+				std::vector<std::string> included{canonicalPath.string()};
+				source.files.push_back(canonicalPath);
+				appendRoot(loadFile(canonicalPath), canonicalPath.parent_path(), defines, included, source);
+				return source;
+			});
+		}
+
+		/**
+		 * @brief Resolve a shader source held in memory.
+		 * @param code The shader source.
+		 * @param directory Directory quoted #includes are resolved relative to.
+		 * @param defines Defines to inject after the #version directive.
+		 * @return The resolved source, cached until a file it includes is invalidated.
+		 * @throws ErrCode::ShaderFileReadFailed If a file it includes can't be read.
+		 * @throws ErrCode::ShaderIncludeFailed If an #include is malformed or the file it names can't be found.
+		 */
+		const PreprocessedSource& preprocessString(const std::string& code, const std::filesystem::path& directory = {},
+			const std::vector<std::string>& defines = {})
+		{
+			const std::uint64_t codeHash = detail::fnv1a(directory.string(), detail::fnv1a(code));
+			return resolve(codeHash, defines, [&]
+			{
+				const std::string& contents = m_strings.try_emplace(codeHash, code).first->second;
+
+				PreprocessedSource source;
+				// The in-memory root has no path, but still takes source string 0.
+				std::vector<std::string> included{std::string{}};
+				appendRoot(contents, directory, defines, included, source);
+				return source;
+			});
+		}
+
+		/**
+		 * @brief Forget the cached contents of a file, and every resolved source, so the file is read again the next
+		 * time it's needed. Sources returned earlier are invalidated.
+		 */
+		void invalidateFile(const std::filesystem::path& path)
+		{
+			m_files.erase(std::filesystem::weakly_canonical(path).string());
+			m_resolved.clear();
+		}
+
+		/**
+		 * @brief Forget every cached file and resolved source. Sources returned earlier are invalidated.
+		 */
+		void clear() noexcept
+		{
+			m_files.clear();
+			m_strings.clear();
+			m_resolved.clear();
+		}
+
+		/**
+		 * @brief Get the number of preprocess calls answered from the cache.
+		 */
+		[[nodiscard]] std::size_t getCacheHits() const noexcept { return m_cacheHits; }
+		/**
+		 * @brief Get the number of preprocess calls that had to resolve their source.
+		 */
+		[[nodiscard]] std::size_t getCacheMisses() const noexcept { return m_cacheMisses; }
+
+	private:
+		std::vector<std::filesystem::path> m_includeDirectories;
+		// Node-based, so pieces can point into the cached files however many more are added.
+		std::unordered_map<std::string, MappedFile> m_files;
+		std::unordered_map<std::uint64_t, std::string> m_strings;
+		std::unordered_map<std::uint64_t, PreprocessedSource> m_resolved;
+		std::size_t m_cacheHits = 0;
+		std::size_t m_cacheMisses = 0;
+
+		template<typename Resolver>
+		const PreprocessedSource& resolve(std::uint64_t key, const std::vector<std::string>& defines,
+			const Resolver& resolver)
+		{
+			for (const auto& define : defines)
+				key = detail::fnv1a({"\0", 1}, detail::fnv1a(define, key));
+
+			if (const auto it = m_resolved.find(key); it != m_resolved.end())
+			{
+				++m_cacheHits;
+				return it->second;
+			}
+
+			++m_cacheMisses;
+			PreprocessedSource source = resolver();
+			source.hash = detail::fnv1a({});
+			for (std::size_t i = 0; i < source.strings.size(); ++i)
+				source.hash = detail::fnv1a({source.strings[i], static_cast<std::size_t>(source.lengths[i])}, source.hash);
+
+			return m_resolved.emplace(key, std::move(source)).first->second;
+		}
+
+		std::string_view loadFile(const std::filesystem::path& canonicalPath)
+		{
+			const std::string key = canonicalPath.string();
+			if (const auto it = m_files.find(key); it != m_files.end())
+				return it->second.getView();
+
+			return m_files.emplace(key, MappedFile{canonicalPath}).first->second.getView();
+		}
+
+		/**
+		 * @brief Append the root source, with the define block injected after its #version directive.
+		 */
+		void appendRoot(const std::string_view contents, const std::filesystem::path& directory,
+			const std::vector<std::string>& defines, std::vector<std::string>& included, PreprocessedSource& source)
+		{
+			std::size_t bodyStart = 0;
+			if (const std::size_t versionPos = contents.find("#version"); versionPos != std::string_view::npos)
+			{
+				const std::size_t lineEnd = contents.find('\n', versionPos);
+				bodyStart = lineEnd == std::string_view::npos ? contents.size() : lineEnd + 1;
+				appendPiece(source, contents.data(), bodyStart);
+				if (lineEnd == std::string_view::npos)
+					appendPiece(source, "\n", 1);
+			}
+
+			const auto bodyStartIt = contents.begin() + static_cast<std::ptrdiff_t>(bodyStart);
+			const GLint bodyLine = 1 + static_cast<GLint>(std::count(contents.begin(), bodyStartIt, '\n'));
+			if (!defines.empty())
+			{
+				std::string block;
+				for (const auto& define : defines)
+				{
+					block += "#define ";
+					block += define;
+					block += '\n';
+				}
+
+				appendDirective(source, std::move(block));
+			}
+
+			appendBody(contents.substr(bodyStart), directory, 0, bodyLine, !defines.empty(), included,
+				source);
+		}
+
+		/**
+		 * @brief Append a source, replacing every #include directive in it with the pieces of the included file.
+		 * @param fileIndex The source string number of the file the source is from.
+		 * @param firstLine The line number of the source's first line in that file.
+		 * @param resync Whether a #line directive is needed before the source's first line.
+		 */
+		void appendBody(const std::string_view contents, const std::filesystem::path& directory, const GLint fileIndex,
+			const GLint firstLine, bool resync, std::vector<std::string>& included, PreprocessedSource& source)
+		{
+			std::size_t chunkStart = 0;
+			std::size_t lineStart = 0;
+			GLint chunkLine = firstLine;
+			GLint lineNumber = firstLine;
+
+			// #line directives are only placed before text, so nothing is emitted for empty files or back-to-back
+			// #includes.
+			const auto appendChunk = [&](const std::size_t chunkEnd)
+			{
+				if (chunkEnd == chunkStart)
+					return;
+
+				if (resync)
+					appendLineDirective(source, chunkLine, fileIndex);
+				appendPiece(source, contents.data() + chunkStart, chunkEnd - chunkStart);
+				resync = false;
+			};
+
+			while (lineStart < contents.size())
+			{
+				std::size_t lineEnd = contents.find('\n', lineStart);
+				lineEnd = lineEnd == std::string_view::npos ? contents.size() : lineEnd;
+
+				const std::string_view line = contents.substr(lineStart, lineEnd - lineStart);
+				std::string_view name;
+				bool quoted;
+				if (parseInclude(line, name, quoted))
+				{
+					appendChunk(lineStart);
+
+					const std::filesystem::path path = findInclude(name, quoted, directory);
+					if (std::find(included.begin(), included.end(), path.string()) == included.end())
+					{
+						included.push_back(path.string());
+						source.files.push_back(path);
+
+						const GLint includedIndex = static_cast<GLint>(included.size() - 1);
+						const std::string_view includedContents = loadFile(path);
+						appendBody(includedContents, path.parent_path(), includedIndex, 1, true, included, source);
+						if (!includedContents.empty() && includedContents.back() != '\n')
+							appendPiece(source, "\n", 1);
+					}
+
+					// The #include line is dropped, so resync even if the file was already included.
+					chunkStart = lineEnd == contents.size() ? lineEnd : lineEnd + 1;
+					chunkLine = lineNumber + 1;
+					resync = true;
+				}
+
+				lineStart = lineEnd + 1;
+				++lineNumber;
+			}
+
+			appendChunk(contents.size());
+		}
+
+		/**
+		 * @brief Check whether a line is an #include directive and get the name it includes.
+		 * @throws ErrCode::ShaderIncludeFailed If the line is a malformed #include directive.
+		 */
+		static bool parseInclude(std::string_view line, std::string_view& name, bool& quoted)
+		{
+			const auto skipSpace = [&]
+			{
+				while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+					line.remove_prefix(1);
+			};
+
+			skipSpace();
+			if (line.empty() || line.front() != '#')
+				return false;
+
+			line.remove_prefix(1);
+			skipSpace();
+			if (line.substr(0, 7) != "include")
+				return false;
+
+			line.remove_prefix(7);
+			skipSpace();
+
+			const char close = !line.empty() && line.front() == '<' ? '>' : '"';
+			const std::size_t end = line.size() > 1 ? line.find(close, 1) : std::string_view::npos;
+			if (line.empty() || (line.front() != '"' && line.front() != '<') || end == std::string_view::npos)
+				detail::throwErr(ErrCode::ShaderIncludeFailed, "Malformed #include directive in shader source.");
+
+			name = line.substr(1, end - 1);
+			quoted = close == '"';
+			return true;
+		}
+
+		/**
+		 * @brief Find the file an #include refers to.
+		 * @throws ErrCode::ShaderIncludeFailed If it can't be found.
+		 */
+		[[nodiscard]] std::filesystem::path findInclude(const std::string_view name, const bool quoted,
+			const std::filesystem::path& directory) const
+		{
+			std::error_code error;
+			if (quoted)
+				if (const auto path = directory / name; std::filesystem::is_regular_file(path, error))
+					return std::filesystem::weakly_canonical(path);
+
+			for (const auto& includeDirectory : m_includeDirectories)
+				if (const auto path = includeDirectory / name; std::filesystem::is_regular_file(path, error))
+					return std::filesystem::weakly_canonical(path);
+
+			detail::logErrStart() << "Failed to find shader include \"" << name << "\"." << detail::logErrEnd;
+			detail::throwErr(ErrCode::ShaderIncludeFailed, "Failed to find shader include.");
+			return {};
+		}
+
+		static void appendDirective(PreprocessedSource& source, std::string directive)
+		{
+			// A deque never moves its elements, so earlier pieces stay valid.
+			const std::string& stored = source.directives->emplace_back(std::move(directive));
+			appendPiece(source, stored.data(), stored.size());
+		}
+
+		static void appendLineDirective(PreprocessedSource& source, const GLint line, const GLint fileIndex)
+		{
+			appendDirective(source, "#line " + std::to_string(line) + ' ' + std::to_string(fileIndex) + '\n');
+		}
+
+		static void appendPiece(PreprocessedSource& source, const char* data, const std::size_t length)
+		{
+			if (length == 0)
+				return;
+
+			source.strings.push_back(data);
+			source.lengths.push_back(static_cast<GLint>(length));
+		}
+	};
+}
+
+#endif //GAL_SHADER_PREPROCESSOR_HPP
@@ -0,0 +1,129 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_UNIFORM_LOCATION_HPP
+#define GAL_UNIFORM_LOCATION_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace gal
+{
+	namespace detail
+	{
+		/**
+		 * @brief 64-bit FNV-1a hash, usable at compile time.
+		 */
+		constexpr std::uint64_t fnv1a(const std::string_view str, std::uint64_t hash = 0xCBF29CE484222325ull) noexcept
+		{
+			for (const char c : str)
+			{
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 0x100000001B3ull;
+			}
+
+			return hash;
+		}
+	}
+
+	/**
+	 * @brief A uniform name along with its hash. Declare names constexpr to have them hashed at compile time:
+	 * @code constexpr gal::UniformName MODEL{"model"}; @endcode
+	 * The name isn't copied, so the string it refers to must outlive it.
+	 */
+	class UniformName
+	{
+	public:
+		constexpr UniformName(const char* name) noexcept : UniformName(std::string_view{name}) { }
+		constexpr UniformName(const std::string_view name) noexcept : m_name(name), m_hash(detail::fnv1a(name)) { }
+		UniformName(const std::string& name) noexcept : UniformName(std::string_view{name}) { }
+
+		[[nodiscard]] constexpr std::string_view getName() const noexcept { return m_name; }
+		[[nodiscard]] constexpr std::uint64_t getHash() const noexcept { return m_hash; }
+
+	private:
+		std::string_view m_name;
+		std::uint64_t m_hash;
+	};
+
+	/**
+	 * @brief A uniform location resolved ahead of time with Program::getUniformLocation(). Setting a uniform through
+	 * one skips the name lookup entirely. Only valid for the program it was resolved from, until it's relinked.
+	 */
+	class UniformLocation
+	{
+	public:
+		constexpr explicit UniformLocation(const GLint location) noexcept : m_location(location) { }
+
+		/**
+		 * @brief Get the raw OpenGL uniform location.
+		 */
+		[[nodiscard]] constexpr GLint get() const noexcept { return m_location; }
+		/**
+		 * @brief Check whether the location refers to an active uniform. Setting an invalid location is a no-op.
+		 */
+		[[nodiscard]] constexpr bool isValid() const noexcept { return m_location != -1; }
+
+	private:
+		GLint m_location;
+	};
+
+	/**
+	 * @brief Refers to a uniform either by name or by a pre-resolved location. This is what the Program uniform
+	 * setters take, so any of a string literal, std::string, std::string_view, UniformName or UniformLocation can be
+	 * passed to them without allocating.
+	 */
+	class UniformRef
+	{
+	public:
+		constexpr UniformRef(const char* name) noexcept : m_name(name), m_location(-1), m_resolved(false) { }
+		constexpr UniformRef(const std::string_view name) noexcept : m_name(name), m_location(-1), m_resolved(false) { }
+		UniformRef(const std::string& name) noexcept : m_name(name), m_location(-1), m_resolved(false) { }
+		constexpr UniformRef(const UniformName name) noexcept : m_name(name), m_location(-1), m_resolved(false) { }
+		constexpr UniformRef(const UniformLocation location) noexcept
+			: m_name(std::string_view{}), m_location(location.get()), m_resolved(true) { }
+
+		/**
+		 * @brief Check whether this refers to a pre-resolved location rather than a name.
+		 */
+		[[nodiscard]] constexpr bool isResolved() const noexcept { return m_resolved; }
+		/**
+		 * @brief Get the name referred to. Only meaningful if isResolved() is false.
+		 */
+		[[nodiscard]] constexpr const UniformName& getName() const noexcept { return m_name; }
+		/**
+		 * @brief Get the location referred to. Only meaningful if isResolved() is true.
+		 */
+		[[nodiscard]] constexpr GLint getLocation() const noexcept { return m_location; }
+
+	private:
+		UniformName m_name;
+		GLint m_location;
+		bool m_resolved;
+	};
+
+	/**
+	 * @brief Any single value a Program uniform setter accepts.
+	 */
+	using UniformValue = std::variant<
+		GLfloat, glm::vec1, glm::vec2, glm::vec3, glm::vec4,
+		bool,
+		GLint, glm::ivec1, glm::ivec2, glm::ivec3, glm::ivec4,
+		GLuint, glm::uvec1, glm::uvec2, glm::uvec3, glm::uvec4,
+		glm::mat2, glm::mat3, glm::mat4, glm::mat2x3, glm::mat3x2, glm::mat2x4, glm::mat4x2, glm::mat3x4, glm::mat4x3
+	>;
+
+	/**
+	 * @brief A uniform paired with the value to set it to, for Program::setUniforms().
+	 */
+	struct UniformAssignment
+	{
+		UniformRef uniform;
+		UniformValue value;
+	};
+}
+
+#endif //GAL_UNIFORM_LOCATION_HPP
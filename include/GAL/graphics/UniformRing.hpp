@@ -0,0 +1,235 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_UNIFORM_RING_HPP
+#define GAL_UNIFORM_RING_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "Buffer.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief Get GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, the alignment of offsets uniform buffer ranges can be bound at.
+	 * Queried once, when GAL is post-GL initialized (or on the first call if it wasn't).
+	 */
+	[[nodiscard]] inline GLint getUniformBufferOffsetAlignment() noexcept
+	{
+		if (detail::g_uniformBufferOffsetAlignment == 0)
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &detail::g_uniformBufferOffsetAlignment);
+		return detail::g_uniformBufferOffsetAlignment;
+	}
+
+	/**
+	 * @brief A slice of a UniformRing, holding the constants of one draw.
+	 */
+	struct UniformSlice
+	{
+		/// Pointer to the slice in the ring's persistently mapped memory. Write the constants here.
+		void* data;
+		/// Offset of the slice within the ring's buffer, a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+		GLintptr offset;
+		/// Size of the slice in bytes.
+		GLsizeiptr size;
+	};
+
+	/**
+	 * @brief A single large uniform buffer that per-draw constants are sub-allocated from, like dynamic uniform
+	 * offsets in Vulkan. Each draw's constants are written straight into a persistently mapped slice and the slice is
+	 * bound with glBindBufferRange(), so setting a draw's uniforms costs a memcpy and one bind instead of a
+	 * glProgramUniform*() call per uniform.
+	 *
+	 * The ring is split into one region per frame in flight. Each frame allocates from its own region, and
+	 * beginFrame() only waits for the GPU if it's still reading the region from that many frames ago.
+	 *
+	 * @code
+	 * gal::UniformRing ring{64 * 1024};
+	 * // Each frame:
+	 * ring.beginFrame();
+	 * for (const auto& object : objects)
+	 * {
+	 *     ring.bind(0, ring.push(object.constants)); // Block declared with layout(std140, binding = 0).
+	 *     object.draw();
+	 * }
+	 * ring.endFrame();
+	 * @endcode
+	 */
+	class UniformRing
+	{
+	public:
+		/**
+		 * @brief Create a uniform ring and map it.
+		 * @param frameCapacity Bytes available to each frame, including the padding between slices.
+		 * @param framesInFlight Number of frames the CPU may run ahead of the GPU before beginFrame() waits.
+		 * @throws ErrCode::CreateBufferFailed If creating the buffer fails.
+		 * @throws ErrCode::MapBufferFailed If mapping the buffer fails.
+		 */
+		explicit UniformRing(const GLsizeiptr frameCapacity, const std::size_t framesInFlight = 3)
+			: m_alignment(getUniformBufferOffsetAlignment()),
+			m_frameCapacity((frameCapacity + m_alignment - 1) / m_alignment * m_alignment),
+			m_fences(framesInFlight, nullptr), m_frame(framesInFlight - 1)
+		{
+			detail::logInfo("Creating uniform ring...");
+			detail::logIncreaseIndent();
+
+			const GLsizeiptr size = m_frameCapacity * static_cast<GLsizeiptr>(framesInFlight);
+			m_buffer.allocateStorage(size, nullptr,
+				BufferStorageFlags::MapWrite | BufferStorageFlags::MapPersistent | BufferStorageFlags::MapCoherent);
+			m_data = static_cast<std::byte*>(m_buffer.mapRange(0, size,
+				BufferMapFlags::Write | BufferMapFlags::Persistent | BufferMapFlags::Coherent));
+
+			detail::logInfoStart() << "Successfully created uniform ring of " << framesInFlight << " frames of " <<
+				m_frameCapacity << " bytes, aligned to " << m_alignment << " bytes." << detail::logInfoEnd;
+			detail::logDecreaseIndent();
+		}
+
+		UniformRing(const UniformRing&) = delete;
+		UniformRing& operator=(const UniformRing&) = delete;
+		UniformRing(UniformRing&&) noexcept = default;
+		UniformRing& operator=(UniformRing&&) = delete;
+
+		~UniformRing()
+		{
+			for (const GLsync fence : m_fences)
+				if (fence)
+					glDeleteSync(fence);
+		}
+
+		/**
+		 * @brief Start allocating from the next frame's region, first waiting for the GPU to finish reading it if
+		 * it's still in use.
+		 */
+		void beginFrame()
+		{
+			m_frame = (m_frame + 1) % m_fences.size();
+			m_head = 0;
+
+			GLsync& fence = m_fences[m_frame];
+			if (!fence)
+				return;
+
+			if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+			{
+				++m_stalls;
+				GLenum status;
+				do
+					status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+				while (status == GL_TIMEOUT_EXPIRED);
+			}
+
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		/**
+		 * @brief Mark the end of the frame's draws, so its region is reused once the GPU has finished them.
+		 */
+		void endFrame()
+		{
+			GLsync& fence = m_fences[m_frame];
+			if (fence)
+				glDeleteSync(fence);
+			fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		/**
+		 * @brief Allocate a slice from the current frame's region. Write the constants into it before the draw that
+		 * reads them is issued.
+		 * @param size Size of the slice in bytes.
+		 * @return The slice.
+		 * @throws ErrCode::UniformRingOverflow If the frame's region is full.
+		 */
+		[[nodiscard]] UniformSlice allocate(const GLsizeiptr size)
+		{
+			const GLsizeiptr offset = (m_head + m_alignment - 1) / m_alignment * m_alignment;
+			if (offset + size > m_frameCapacity)
+			{
+				detail::logErrStart() << "Uniform ring frame capacity of " << m_frameCapacity << " bytes exceeded by a " <<
+					size << " byte allocation." << detail::logErrEnd;
+				detail::throwErr(ErrCode::UniformRingOverflow, "Uniform ring frame capacity exceeded.");
+			}
+
+			m_head = offset + size;
+			const GLintptr absoluteOffset = static_cast<GLintptr>(m_frame) * m_frameCapacity + offset;
+			return {m_data + absoluteOffset, absoluteOffset, size};
+		}
+
+		/**
+		 * @brief Allocate a slice and copy constants into it.
+		 * @param data Pointer to the constants.
+		 * @param size Size of the constants in bytes.
+		 * @return The slice.
+		 * @throws ErrCode::UniformRingOverflow If the frame's region is full.
+		 */
+		UniformSlice push(const void* data, const GLsizeiptr size)
+		{
+			const UniformSlice slice = allocate(size);
+			std::memcpy(slice.data, data, size);
+			return slice;
+		}
+
+		/**
+		 * @brief Allocate a slice and copy a struct of constants into it. Check the struct's layout against the block
+		 * with matchesBlockLayout().
+		 * @param constants The constants.
+		 * @return The slice.
+		 * @throws ErrCode::UniformRingOverflow If the frame's region is full.
+		 */
+		template<typename T>
+		UniformSlice push(const T& constants)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Uniform ring constants must be trivially copyable.");
+			return push(&constants, sizeof(T));
+		}
+
+		/**
+		 * @brief Bind a slice to a uniform buffer binding index, so the uniform block assigned to that index reads it.
+		 * @param binding The binding index.
+		 * @param slice The slice.
+		 */
+		void bind(const GLuint binding, const UniformSlice& slice) const noexcept
+		{
+			m_buffer.bindIndexedRange(IndexedBufferTarget::Uniform, binding, slice.offset, slice.size);
+		}
+
+		/**
+		 * @brief Get the buffer backing the ring.
+		 */
+		[[nodiscard]] const Buffer& getBuffer() const noexcept { return m_buffer; }
+		/**
+		 * @brief Get the alignment of slices, i.e., GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+		 */
+		[[nodiscard]] GLsizeiptr getAlignment() const noexcept { return m_alignment; }
+		/**
+		 * @brief Get the number of bytes available to each frame.
+		 */
+		[[nodiscard]] GLsizeiptr getFrameCapacity() const noexcept { return m_frameCapacity; }
+		/**
+		 * @brief Get the number of bytes allocated so far this frame, including padding between slices.
+		 */
+		[[nodiscard]] GLsizeiptr getFrameUsage() const noexcept { return m_head; }
+		/**
+		 * @brief Get the number of times beginFrame() had to wait for the GPU. If this keeps growing, add frames in
+		 * flight.
+		 */
+		[[nodiscard]] std::size_t getStallCount() const noexcept { return m_stalls; }
+
+	private:
+		Buffer m_buffer;
+		GLsizeiptr m_alignment;
+		GLsizeiptr m_frameCapacity;
+		std::byte* m_data = nullptr;
+
+		std::vector<GLsync> m_fences;
+		std::size_t m_frame;
+		GLsizeiptr m_head = 0;
+		std::size_t m_stalls = 0;
+	};
+}
+
+#endif //GAL_UNIFORM_RING_HPP
@@ -11,6 +11,8 @@ namespace gal
 	{
 		inline void vertexArrayDeleter(const VertexArrayID id) noexcept
 		{
+			if (g_currentGLState)
+				g_currentGLState->forgetVertexArray(id);
 			glDeleteVertexArrays(1, &id);
 		}
 
@@ -43,9 +45,9 @@ namespace gal
 		[[nodiscard]] VertexArrayID getID() const noexcept { return getHandle(); }
 
 		/**
-		 * @brief Bind the vertex array for use.
+		 * @brief Bind the vertex array for use. Does nothing if it's already bound.
 		 */
-		void bind() const noexcept { glBindVertexArray(getHandle()); }
+		void bind() const noexcept { detail::bindVertexArray(getHandle()); }
 
 		/**
 		 * @brief Bind a buffer to be this vertex array's vertex buffer for the given index.
@@ -134,6 +136,44 @@ namespace gal
 			glVertexArrayAttribBinding(getHandle(), attributeIndex, bufferIndex);
 		}
 
+		/**
+		 * @brief Define and enable a new vertex attribute for data packed with packVertices(), picking the data type,
+		 * component count and normalization that match the packing.
+		 * @param attributeIndex Index of the new attribute.
+		 * @param bufferIndex Index of the buffer whose data to use.
+		 * @param packing How the attribute's data was packed.
+		 * @param components Number of components in the unpacked attribute. Ignored for OctahedralSnorm16, which is
+		 * always read as a normalized vec2 (decode it with OCTAHEDRAL_DECODE_GLSL), and Int2101010Rev, which is always
+		 * read as a normalized vec4.
+		 * @param relativeOffset The offset from the beginning of a packed vertex's data to this attribute, as given in
+		 * PackedVertices::offsets.
+		 */
+		void vertexAttributePackedFormat(const GLuint attributeIndex, const GLuint bufferIndex,
+			const VertexAttributePacking packing, const GLint components, const GLuint relativeOffset) const noexcept
+		{
+			switch (packing)
+			{
+				case VertexAttributePacking::Float32:
+					vertexAttributeFormat(attributeIndex, bufferIndex, components, GL_FLOAT, false, relativeOffset);
+					break;
+				case VertexAttributePacking::Half:
+					vertexAttributeFormat(attributeIndex, bufferIndex, components, GL_HALF_FLOAT, false, relativeOffset);
+					break;
+				case VertexAttributePacking::Snorm16:
+					vertexAttributeFormat(attributeIndex, bufferIndex, components, GL_SHORT, true, relativeOffset);
+					break;
+				case VertexAttributePacking::Unorm8:
+					vertexAttributeFormat(attributeIndex, bufferIndex, components, GL_UNSIGNED_BYTE, true, relativeOffset);
+					break;
+				case VertexAttributePacking::OctahedralSnorm16:
+					vertexAttributeFormat(attributeIndex, bufferIndex, 2, GL_SHORT, true, relativeOffset);
+					break;
+				case VertexAttributePacking::Int2101010Rev:
+					vertexAttributeFormat(attributeIndex, bufferIndex, 4, GL_INT_2_10_10_10_REV, true, relativeOffset);
+					break;
+			}
+		}
+
 		/**
 		 * @brief Bind a buffer to be this vertex array's element buffer.
 		 * @param bufferID The ID of the buffer to bind.
@@ -154,6 +194,15 @@ namespace gal
 			bindElementBuffer(buffer.getID());
 		}
 
+		/**
+		 * @brief Bind an index buffer to be this vertex array's element buffer. Draw it with IndexBuffer::draw().
+		 * @param indexBuffer The index buffer to bind.
+		 */
+		void bindElementBuffer(const IndexBuffer& indexBuffer) const noexcept
+		{
+			bindElementBuffer(indexBuffer.getBuffer().getID());
+		}
+
 		/**
 		 * @brief Unbind (bind to 0) this vertex array's element buffer.
 		 */
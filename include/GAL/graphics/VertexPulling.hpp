@@ -0,0 +1,253 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_VERTEX_PULLING_HPP
+#define GAL_VERTEX_PULLING_HPP
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Buffer.hpp"
+#include "Shader.hpp"
+#include "VertexArray.hpp"
+
+namespace gal
+{
+	namespace detail
+	{
+		/**
+		 * @brief Get the number of components in a pulled attribute type.
+		 */
+		inline GLuint pulledAttributeComponents(const PulledAttributeType type) noexcept
+		{
+			return static_cast<GLuint>(type) % 4 + 1;
+		}
+
+		/**
+		 * @brief Get the GLSL name of a pulled attribute type.
+		 */
+		inline const char* pulledAttributeGLSLType(const PulledAttributeType type) noexcept
+		{
+			switch (type)
+			{
+				case PulledAttributeType::Float: return "float";
+				case PulledAttributeType::Vec2:  return "vec2";
+				case PulledAttributeType::Vec3:  return "vec3";
+				case PulledAttributeType::Vec4:  return "vec4";
+				case PulledAttributeType::Int:   return "int";
+				case PulledAttributeType::IVec2: return "ivec2";
+				case PulledAttributeType::IVec3: return "ivec3";
+				case PulledAttributeType::IVec4: return "ivec4";
+				case PulledAttributeType::UInt:  return "uint";
+				case PulledAttributeType::UVec2: return "uvec2";
+				case PulledAttributeType::UVec3: return "uvec3";
+				case PulledAttributeType::UVec4: return "uvec4";
+			}
+
+			return "float";
+		}
+
+		/**
+		 * @brief Get the GLSL function that reinterprets a raw uint word as a component of the given attribute type.
+		 * Returns an empty string for unsigned types, which need no conversion.
+		 */
+		inline const char* pulledAttributeBitcast(const PulledAttributeType type) noexcept
+		{
+			if (type <= PulledAttributeType::Vec4)
+				return "uintBitsToFloat";
+			if (type <= PulledAttributeType::IVec4)
+				return "int";
+			return "";
+		}
+	}
+
+	/**
+	 * @brief Description of a C++ vertex struct, used to generate GLSL that fetches vertices from a shader storage
+	 * buffer by gl_VertexID instead of through fixed-function vertex attributes.
+	 *
+	 * Vertex data is read from the SSBO as raw 32-bit words, so every attribute must be 4-byte aligned but otherwise
+	 * the C++ struct's layout is reproduced exactly (no std430 padding rules apply).
+	 */
+	class VertexPullingLayout
+	{
+	public:
+		/**
+		 * @brief Create an empty layout for vertices of the given size.
+		 * @param stride Size of each vertex in bytes. Must be a multiple of 4.
+		 * @param structName Name of the GLSL struct the generated code fetches vertices into.
+		 * @throws ErrCode::InvalidVertexPullingLayout If stride isn't a positive multiple of 4.
+		 */
+		explicit VertexPullingLayout(const GLsizei stride, std::string structName = "PulledVertex")
+			: m_stride(stride), m_structName(std::move(structName))
+		{
+			if (stride <= 0 || stride % 4 != 0)
+				detail::throwErr(ErrCode::InvalidVertexPullingLayout,
+					"Vertex pulling stride must be a positive multiple of 4 bytes.");
+		}
+
+		/**
+		 * @brief Create an empty layout for vertices of the given C++ type.
+		 * @tparam Vertex The vertex struct. Its size must be a multiple of 4.
+		 * @param structName Name of the GLSL struct the generated code fetches vertices into.
+		 */
+		template<typename Vertex>
+		[[nodiscard]] static VertexPullingLayout forVertex(std::string structName = "PulledVertex")
+		{
+			static_assert(sizeof(Vertex) % 4 == 0, "Pulled vertex types must have a size that is a multiple of 4.");
+			return VertexPullingLayout(static_cast<GLsizei>(sizeof(Vertex)), std::move(structName));
+		}
+
+		/**
+		 * @brief Add an attribute to the layout.
+		 * @param name Name of the attribute's member in the generated GLSL struct.
+		 * @param type GLSL type of the attribute. Each component is read as one 32-bit word.
+		 * @param offset Byte offset of the attribute in the vertex. Think offsetof(VertexType, member).
+		 * @return Reference to this layout for chaining.
+		 * @throws ErrCode::InvalidVertexPullingLayout If the offset isn't 4-byte aligned or the attribute doesn't fit
+		 * in the stride.
+		 */
+		VertexPullingLayout& attribute(std::string name, const PulledAttributeType type, const GLuint offset)
+		{
+			const GLuint size = detail::pulledAttributeComponents(type) * 4;
+			if (offset % 4 != 0 || offset + size > static_cast<GLuint>(m_stride))
+				detail::throwErr(ErrCode::InvalidVertexPullingLayout,
+					"Pulled vertex attribute must be 4-byte aligned and fit inside the vertex stride.");
+
+			m_attributes.push_back({std::move(name), type, offset});
+			return *this;
+		}
+
+		/**
+		 * @brief Get the size of each vertex in bytes.
+		 */
+		[[nodiscard]] GLsizei getStride() const noexcept { return m_stride; }
+
+		/**
+		 * @brief Generate the GLSL declarations and accessor functions for this layout.
+		 * @param vertexBinding Shader storage binding index the vertex buffer will be bound to.
+		 * @param indexBinding Shader storage binding index the (32-bit) index buffer will be bound to.
+		 * @return GLSL source declaring the vertex struct, both storage blocks, pullIndex(uint), pullVertex(uint) and
+		 * pullCurrentVertex(), which fetches the vertex for gl_VertexID through the index buffer.
+		 */
+		[[nodiscard]] std::string generateGLSL(const GLuint vertexBinding = 0, const GLuint indexBinding = 1) const
+		{
+			std::ostringstream glsl;
+
+			glsl << "struct " << m_structName << "\n{\n";
+			for (const auto& attribute : m_attributes)
+				glsl << "\t" << detail::pulledAttributeGLSLType(attribute.type) << " " << attribute.name << ";\n";
+			glsl << "};\n\n";
+
+			glsl << "layout(std430, binding = " << vertexBinding << ") restrict readonly buffer GALPulledVertices\n"
+				"{\n\tuint galPulledVertexData[];\n};\n\n";
+			glsl << "layout(std430, binding = " << indexBinding << ") restrict readonly buffer GALPulledIndices\n"
+				"{\n\tuint galPulledIndexData[];\n};\n\n";
+
+			glsl << "uint pullIndex(uint i)\n{\n\treturn galPulledIndexData[i];\n}\n\n";
+
+			glsl << m_structName << " pullVertex(uint vertexIndex)\n{\n";
+			glsl << "\tuint base = vertexIndex * " << m_stride / 4 << "u;\n";
+			glsl << "\t" << m_structName << " vertex;\n";
+			for (const auto& attribute : m_attributes)
+			{
+				const GLuint components = detail::pulledAttributeComponents(attribute.type);
+				const char* bitcast = detail::pulledAttributeBitcast(attribute.type);
+
+				glsl << "\tvertex." << attribute.name << " = " << detail::pulledAttributeGLSLType(attribute.type) << "(";
+				for (GLuint i = 0; i < components; ++i)
+				{
+					if (i != 0)
+						glsl << ", ";
+					glsl << bitcast << "(galPulledVertexData[base + " << attribute.offset / 4 + i << "u])";
+				}
+				glsl << ");\n";
+			}
+			glsl << "\treturn vertex;\n}\n\n";
+
+			glsl << m_structName << " pullCurrentVertex()\n{\n\treturn pullVertex(pullIndex(uint(gl_VertexID)));\n}\n";
+
+			return glsl.str();
+		}
+
+		/**
+		 * @brief Insert the generated GLSL into a vertex shader source, after its #version and #extension directives.
+		 * @param source The vertex shader source, which may then call pullCurrentVertex() from main().
+		 * @param vertexBinding Shader storage binding index the vertex buffer will be bound to.
+		 * @param indexBinding Shader storage binding index the index buffer will be bound to.
+		 * @return The combined source, ready to be passed to Shader::sourceString().
+		 */
+		[[nodiscard]] std::string injectInto(const std::string& source, const GLuint vertexBinding = 0,
+			const GLuint indexBinding = 1) const
+		{
+			return detail::insertAfterLeadingDirectives(source, generateGLSL(vertexBinding, indexBinding));
+		}
+
+	private:
+		struct Attribute
+		{
+			std::string name;
+			PulledAttributeType type;
+			GLuint offset;
+		};
+
+		GLsizei m_stride;
+		std::string m_structName;
+		std::vector<Attribute> m_attributes;
+	};
+
+	/**
+	 * @brief Draws vertices fetched with a VertexPullingLayout. Owns the single empty vertex array that is bound for
+	 * every pulled draw, so switching meshes only rebinds shader storage buffers and never switches vertex arrays.
+	 */
+	class VertexPuller
+	{
+	public:
+		/**
+		 * @brief Create a vertex puller and its empty vertex array.
+		 * @param vertexBinding Shader storage binding index vertex buffers are bound to. Must match the one passed to
+		 * VertexPullingLayout::generateGLSL().
+		 * @param indexBinding Shader storage binding index index buffers are bound to. Must match the one passed to
+		 * VertexPullingLayout::generateGLSL().
+		 * @throws ErrCode::CreateVertexArrayFailed If creating the vertex array fails.
+		 */
+		explicit VertexPuller(const GLuint vertexBinding = 0, const GLuint indexBinding = 1)
+			: m_vertexBinding(vertexBinding), m_indexBinding(indexBinding) { }
+
+		/**
+		 * @brief Get the vertex array bound for pulled draws.
+		 */
+		[[nodiscard]] const VertexArray& getVertexArray() const noexcept { return m_vertexArray; }
+
+		/**
+		 * @brief Bind the empty vertex array along with a mesh's vertex and (32-bit) index buffers.
+		 * @param vertices Buffer with the mesh's vertices, laid out as described by the VertexPullingLayout.
+		 * @param indices Buffer with the mesh's indices as GLuints.
+		 */
+		void bind(const Buffer& vertices, const Buffer& indices) const noexcept
+		{
+			m_vertexArray.bind();
+			vertices.bindIndexed(IndexedBufferTarget::ShaderStorage, m_vertexBinding);
+			indices.bindIndexed(IndexedBufferTarget::ShaderStorage, m_indexBinding);
+		}
+
+		/**
+		 * @brief Draw pulled vertices. Call bind() first.
+		 * @param mode The primitive type to draw.
+		 * @param indexCount Number of indices to pull, starting at the first.
+		 * @param instanceCount Number of instances to draw.
+		 */
+		void draw(const DrawMode mode, const GLsizei indexCount, const GLsizei instanceCount = 1) const noexcept
+		{
+			glDrawArraysInstanced(static_cast<GLenum>(mode), 0, indexCount, instanceCount);
+		}
+
+	private:
+		VertexArray m_vertexArray;
+		GLuint m_vertexBinding;
+		GLuint m_indexBinding;
+	};
+}
+
+#endif //GAL_VERTEX_PULLING_HPP
@@ -5,10 +5,29 @@
 #ifndef GAL_GRAPHICS_HPP
 #define GAL_GRAPHICS_HPP
 
+#include "BarrierTracker.hpp"
+#include "BlockLayout.hpp"
 #include "Buffer.hpp"
+#include "DrawIndirectBuffer.hpp"
+#include "GPUCulling.hpp"
+#include "HiZPyramid.hpp"
+#include "IndexBuffer.hpp"
 #include "Program.hpp"
+#include "ProgramBatch.hpp"
+#include "ProgramBinaryCache.hpp"
+#include "ProgramLibrary.hpp"
+#include "ProgramPipeline.hpp"
+#include "ProgramReflection.hpp"
+#include "RenderQueue.hpp"
 #include "Shader.hpp"
+#include "ShaderCache.hpp"
+#include "ShaderFileLoader.hpp"
+#include "ShaderHotReload.hpp"
+#include "ShaderPreprocessor.hpp"
 #include "Texture.hpp"
+#include "UniformLocation.hpp"
+#include "UniformRing.hpp"
 #include "VertexArray.hpp"
+#include "VertexPulling.hpp"
 
 #endif //GAL_GRAPHICS_HPP
\ No newline at end of file
@@ -0,0 +1,586 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_MESH_OPTIMIZER_HPP
+#define GAL_MESH_OPTIMIZER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GAL/detail/parallel.hpp"
+
+namespace gal
+{
+	/**
+	 * @brief An indexed triangle list mesh in CPU memory, as it would be written to a vertex buffer and an element
+	 * buffer with Buffer::allocateAndWrite().
+	 */
+	struct MeshData
+	{
+		/// Interleaved vertex data.
+		std::vector<std::byte> vertices;
+		/// Size of each vertex in bytes.
+		GLsizei vertexStride = 0;
+		/// Byte offset of each vertex's position, stored as three GLfloats. Only used for overdraw optimization.
+		GLuint positionOffset = 0;
+		/// Triangle list indices.
+		std::vector<GLuint> indices;
+
+		/**
+		 * @brief Get the number of vertices in the mesh.
+		 */
+		[[nodiscard]] GLuint getVertexCount() const noexcept
+		{
+			return vertexStride > 0 ? static_cast<GLuint>(vertices.size() / vertexStride) : 0;
+		}
+	};
+
+	/**
+	 * @brief Post-transform vertex cache efficiency of an index buffer.
+	 */
+	struct VertexCacheStats
+	{
+		/// Average cache miss ratio: vertex shader invocations per triangle. 0.5 is ideal for large regular grids, 3 is
+		/// the worst case.
+		float acmr = 0.0f;
+		/// Average transform to vertex ratio: vertex shader invocations per referenced vertex. 1 is ideal.
+		float atvr = 0.0f;
+	};
+
+	/**
+	 * @brief Settings for optimizeMesh() and optimizeMeshes().
+	 */
+	struct MeshOptimizationSettings
+	{
+		/// Size of the simulated FIFO post-transform cache, used both for optimization and for reporting.
+		GLuint cacheSize = 16;
+		/// How much worse than the cache-optimized order a cluster's ACMR may get when splitting clusters for overdraw
+		/// ordering. Larger values give more, smaller clusters and less overdraw at the expense of cache efficiency.
+		float overdrawThreshold = 1.05f;
+		bool deduplicateVertices = true;
+		bool optimizeVertexCache = true;
+		bool optimizeOverdraw = true;
+		bool optimizeVertexFetch = true;
+		/// Number of worker threads used by optimizeMeshes(). 0 uses std::thread::hardware_concurrency().
+		unsigned threadCount = 0;
+	};
+
+	/**
+	 * @brief Statistics gathered while optimizing a mesh.
+	 */
+	struct MeshOptimizationReport
+	{
+		VertexCacheStats before;
+		VertexCacheStats after;
+		GLuint vertexCountBefore = 0;
+		GLuint vertexCountAfter = 0;
+	};
+
+	/**
+	 * @brief Simulate a FIFO post-transform vertex cache over a triangle list.
+	 * @param indices Triangle list indices.
+	 * @param vertexCount Number of vertices the indices refer to.
+	 * @param cacheSize Number of entries in the simulated cache.
+	 * @return The ACMR and ATVR of the index buffer.
+	 */
+	[[nodiscard]] inline VertexCacheStats analyzeVertexCache(const std::vector<GLuint>& indices,
+		const GLuint vertexCount, const GLuint cacheSize = 16)
+	{
+		VertexCacheStats stats;
+		if (indices.size() < 3 || vertexCount == 0)
+			return stats;
+
+		// Each vertex remembers the timestamp it entered the cache at, so lookup is O(1). A vertex is still cached
+		// if fewer than cacheSize misses have happened since.
+		std::vector<std::size_t> cachedAt(vertexCount, 0);
+		std::vector<bool> referenced(vertexCount, false);
+		std::size_t misses = 0;
+		std::size_t uniqueVertices = 0;
+
+		for (const GLuint index : indices)
+		{
+			if (!referenced[index])
+			{
+				referenced[index] = true;
+				++uniqueVertices;
+			}
+
+			if (cachedAt[index] == 0 || misses - cachedAt[index] >= cacheSize)
+			{
+				++misses;
+				cachedAt[index] = misses;
+			}
+		}
+
+		stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+		stats.atvr = static_cast<float>(misses) / static_cast<float>(uniqueVertices);
+		return stats;
+	}
+
+	/**
+	 * @brief Merge vertices whose data is byte-for-byte identical and remap the indices accordingly.
+	 * @param mesh The mesh to deduplicate.
+	 */
+	inline void deduplicateVertices(MeshData& mesh)
+	{
+		const GLuint vertexCount = mesh.getVertexCount();
+		const auto stride = static_cast<std::size_t>(mesh.vertexStride);
+		const auto* data = reinterpret_cast<const char*>(mesh.vertices.data());
+
+		std::unordered_map<std::string_view, GLuint> uniqueVertices;
+		uniqueVertices.reserve(vertexCount);
+
+		std::vector<GLuint> remap(vertexCount);
+		std::vector<std::byte> vertices;
+		vertices.reserve(mesh.vertices.size());
+
+		for (GLuint i = 0; i < vertexCount; ++i)
+		{
+			const std::string_view vertex{data + i * stride, stride};
+			const auto [it, inserted] = uniqueVertices.try_emplace(vertex,
+				static_cast<GLuint>(vertices.size() / stride));
+
+			if (inserted)
+				vertices.insert(vertices.end(), mesh.vertices.begin() + i * stride,
+					mesh.vertices.begin() + (i + 1) * stride);
+
+			remap[i] = it->second;
+		}
+
+		for (auto& index : mesh.indices)
+			index = remap[index];
+
+		mesh.vertices = std::move(vertices);
+	}
+
+	/**
+	 * @brief Reorder triangles for post-transform vertex cache efficiency using Tipsify (Sander, Nehab and Barczak,
+	 * "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007).
+	 * @param indices Triangle list indices, reordered in place.
+	 * @param vertexCount Number of vertices the indices refer to.
+	 * @param cacheSize Number of entries in the targeted post-transform cache.
+	 * @return The index of the first triangle of every cluster, where a cluster ends whenever Tipsify ran out of
+	 * cached candidates and had to jump elsewhere in the mesh. These are the hard boundaries used by optimizeOverdraw().
+	 */
+	inline std::vector<GLuint> optimizeVertexCache(std::vector<GLuint>& indices, const GLuint vertexCount,
+		const GLuint cacheSize = 16)
+	{
+		const auto triangleCount = static_cast<GLuint>(indices.size() / 3);
+		std::vector<GLuint> clusters;
+		if (triangleCount == 0)
+			return clusters;
+
+		// Vertex-triangle adjacency in compressed form.
+		std::vector<GLuint> liveTriangles(vertexCount, 0);
+		for (GLuint i = 0; i < triangleCount * 3; ++i)
+			++liveTriangles[indices[i]];
+
+		std::vector<GLuint> adjacencyOffsets(vertexCount + 1, 0);
+		for (GLuint v = 0; v < vertexCount; ++v)
+			adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+
+		std::vector<GLuint> adjacency(adjacencyOffsets[vertexCount]);
+		{
+			std::vector<GLuint> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (GLuint t = 0; t < triangleCount; ++t)
+				for (GLuint k = 0; k < 3; ++k)
+					adjacency[fill[indices[t * 3 + k]]++] = t;
+		}
+
+		std::vector<std::size_t> cacheTime(vertexCount, 0);
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<GLuint> deadEnd;
+		std::vector<GLuint> candidates;
+		std::vector<GLuint> result;
+		result.reserve(triangleCount * 3);
+
+		std::size_t time = cacheSize + 1;
+		GLuint cursor = 0;
+		bool startCluster = true;
+
+		const auto skipDeadEnd = [&]() -> GLint
+		{
+			while (!deadEnd.empty())
+			{
+				const GLuint vertex = deadEnd.back();
+				deadEnd.pop_back();
+				if (liveTriangles[vertex] > 0)
+					return static_cast<GLint>(vertex);
+			}
+
+			for (; cursor < vertexCount; ++cursor)
+				if (liveTriangles[cursor] > 0)
+					return static_cast<GLint>(cursor);
+
+			return -1;
+		};
+
+		GLint fanningVertex = skipDeadEnd();
+		while (fanningVertex >= 0)
+		{
+			candidates.clear();
+
+			for (GLuint a = adjacencyOffsets[fanningVertex]; a < adjacencyOffsets[fanningVertex + 1]; ++a)
+			{
+				const GLuint triangle = adjacency[a];
+				if (emitted[triangle])
+					continue;
+
+				if (startCluster)
+				{
+					clusters.push_back(static_cast<GLuint>(result.size() / 3));
+					startCluster = false;
+				}
+
+				for (GLuint k = 0; k < 3; ++k)
+				{
+					const GLuint vertex = indices[triangle * 3 + k];
+					result.push_back(vertex);
+					deadEnd.push_back(vertex);
+					candidates.push_back(vertex);
+					--liveTriangles[vertex];
+
+					if (time - cacheTime[vertex] > cacheSize)
+						cacheTime[vertex] = time++;
+				}
+
+				emitted[triangle] = true;
+			}
+
+			// Pick the candidate that will still be in the cache after its remaining triangles are emitted and has
+			// been in it the longest.
+			GLint next = -1;
+			std::size_t bestPriority = 0;
+			for (const GLuint vertex : candidates)
+			{
+				if (liveTriangles[vertex] == 0)
+					continue;
+
+				std::size_t priority = 0;
+				if (time - cacheTime[vertex] + 2 * liveTriangles[vertex] <= cacheSize)
+					priority = time - cacheTime[vertex];
+
+				if (next == -1 || priority > bestPriority)
+				{
+					bestPriority = priority;
+					next = static_cast<GLint>(vertex);
+				}
+			}
+
+			if (next == -1)
+			{
+				startCluster = true;
+				next = skipDeadEnd();
+			}
+
+			fanningVertex = next;
+		}
+
+		indices = std::move(result);
+		return clusters;
+	}
+
+	/**
+	 * @brief Reorder clusters of triangles so that outward facing clusters are drawn first, reducing overdraw while
+	 * mostly preserving vertex cache efficiency.
+	 * @param mesh The mesh whose indices to reorder. Its indices should already be cache-optimized.
+	 * @param clusters The first triangle of each hard cluster, as returned by optimizeVertexCache().
+	 * @param cacheSize Number of entries in the simulated post-transform cache.
+	 * @param threshold How much worse than its hard cluster's ACMR a soft cluster may be.
+	 */
+	inline void optimizeOverdraw(MeshData& mesh, const std::vector<GLuint>& clusters, const GLuint cacheSize = 16,
+		const float threshold = 1.05f)
+	{
+		const auto triangleCount = static_cast<GLuint>(mesh.indices.size() / 3);
+		if (triangleCount == 0 || clusters.empty())
+			return;
+
+		const GLuint vertexCount = mesh.getVertexCount();
+
+		// Split the hard clusters into smaller soft clusters wherever the ACMR so far is close enough to that of the
+		// whole hard cluster, so there's more freedom to reorder.
+		std::vector<GLuint> softClusters;
+		{
+			// One cache simulation shared by every cluster, as in analyzeVertexCache(). Advancing the miss count by
+			// the cache size evicts everything, so the cache is made cold without clearing the timestamps.
+			std::vector<std::size_t> cachedAt(vertexCount, 0);
+			std::size_t misses = 0;
+
+			const auto triangleMisses = [&](const GLuint triangle)
+			{
+				std::size_t triangleMisses = 0;
+				for (GLuint k = 0; k < 3; ++k)
+				{
+					const GLuint vertex = mesh.indices[triangle * 3 + k];
+					if (cachedAt[vertex] == 0 || misses - cachedAt[vertex] >= cacheSize)
+					{
+						++misses;
+						++triangleMisses;
+						cachedAt[vertex] = misses;
+					}
+				}
+				return triangleMisses;
+			};
+
+			for (std::size_t c = 0; c < clusters.size(); ++c)
+			{
+				const GLuint begin = clusters[c];
+				const GLuint end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+
+				// Measure the whole hard cluster from a cold cache, then its soft clusters from a cold cache too, so
+				// both rates are comparable.
+				misses += cacheSize;
+				std::size_t clusterMisses = 0;
+				for (GLuint t = begin; t < end; ++t)
+					clusterMisses += triangleMisses(t);
+				const float clusterACMR = static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+				misses += cacheSize;
+				softClusters.push_back(begin);
+				std::size_t softMisses = 0;
+				GLuint softStart = begin;
+
+				for (GLuint t = begin; t < end; ++t)
+				{
+					softMisses += triangleMisses(t);
+
+					const GLuint softTriangles = t + 1 - softStart;
+					if (t + 1 < end && static_cast<float>(softMisses) / static_cast<float>(softTriangles) <=
+						clusterACMR * threshold)
+					{
+						softClusters.push_back(t + 1);
+						softStart = t + 1;
+						softMisses = 0;
+						// Start the next cluster with a cold cache, as it may be moved anywhere.
+						misses += cacheSize;
+					}
+				}
+			}
+		}
+
+		const auto position = [&](const GLuint vertex)
+		{
+			glm::vec3 pos;
+			std::memcpy(&pos, mesh.vertices.data() + static_cast<std::size_t>(vertex) * mesh.vertexStride +
+				mesh.positionOffset, sizeof(pos));
+			return pos;
+		};
+
+		// Area-weighted centroid and normal for every cluster and the whole mesh.
+		struct Cluster
+		{
+			GLuint begin;
+			GLuint end;
+			float sortKey;
+		};
+
+		std::vector<Cluster> sortedClusters;
+		std::vector<glm::vec3> centroids;
+		std::vector<glm::vec3> normals;
+		glm::vec3 meshCentroid{0.0f};
+		float meshArea = 0.0f;
+
+		for (std::size_t c = 0; c < softClusters.size(); ++c)
+		{
+			const GLuint begin = softClusters[c];
+			const GLuint end = c + 1 < softClusters.size() ? softClusters[c + 1] : triangleCount;
+
+			glm::vec3 centroid{0.0f};
+			glm::vec3 normal{0.0f};
+			float area = 0.0f;
+
+			for (GLuint t = begin; t < end; ++t)
+			{
+				const glm::vec3 p0 = position(mesh.indices[t * 3]);
+				const glm::vec3 p1 = position(mesh.indices[t * 3 + 1]);
+				const glm::vec3 p2 = position(mesh.indices[t * 3 + 2]);
+
+				const glm::vec3 crossProduct = glm::cross(p1 - p0, p2 - p0);
+				const float triangleArea = glm::length(crossProduct);
+
+				centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+				normal += crossProduct;
+				area += triangleArea;
+			}
+
+			meshCentroid += centroid;
+			meshArea += area;
+
+			centroids.push_back(area > 0.0f ? centroid / area : centroid);
+			normals.push_back(normal);
+			sortedClusters.push_back({begin, end, 0.0f});
+		}
+
+		if (meshArea > 0.0f)
+			meshCentroid /= meshArea;
+
+		for (std::size_t c = 0; c < sortedClusters.size(); ++c)
+		{
+			const float normalLength = glm::length(normals[c]);
+			sortedClusters[c].sortKey = normalLength > 0.0f ?
+				glm::dot(centroids[c] - meshCentroid, normals[c] / normalLength) : 0.0f;
+		}
+
+		std::stable_sort(sortedClusters.begin(), sortedClusters.end(),
+			[](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+		std::vector<GLuint> result;
+		result.reserve(mesh.indices.size());
+		for (const auto& cluster : sortedClusters)
+			result.insert(result.end(), mesh.indices.begin() + cluster.begin * 3,
+				mesh.indices.begin() + cluster.end * 3);
+
+		mesh.indices = std::move(result);
+	}
+
+	/**
+	 * @brief Reorder vertices in the order they're first referenced by the indices, so vertex fetches walk through
+	 * memory linearly. Vertices that aren't referenced at all are removed.
+	 * @param mesh The mesh whose vertices to reorder.
+	 */
+	inline void optimizeVertexFetch(MeshData& mesh)
+	{
+		constexpr GLuint unassigned = ~0u;
+		const auto stride = static_cast<std::size_t>(mesh.vertexStride);
+
+		std::vector<GLuint> remap(mesh.getVertexCount(), unassigned);
+		std::vector<std::byte> vertices;
+		vertices.reserve(mesh.vertices.size());
+
+		for (auto& index : mesh.indices)
+		{
+			if (remap[index] == unassigned)
+			{
+				remap[index] = static_cast<GLuint>(vertices.size() / stride);
+				vertices.insert(vertices.end(), mesh.vertices.begin() + index * stride,
+					mesh.vertices.begin() + (index + 1) * stride);
+			}
+
+			index = remap[index];
+		}
+
+		mesh.vertices = std::move(vertices);
+	}
+
+	namespace detail
+	{
+		inline bool meshValid(const MeshData& mesh) noexcept
+		{
+			const GLuint vertexCount = mesh.getVertexCount();
+			return mesh.vertexStride > 0 && mesh.vertices.size() % mesh.vertexStride == 0 &&
+				mesh.indices.size() % 3 == 0 &&
+				std::none_of(mesh.indices.begin(), mesh.indices.end(), [&](const GLuint i) { return i >= vertexCount; });
+		}
+
+		/**
+		 * @brief Run the passes of optimizeMesh() on a valid mesh without logging, so it can run on worker threads.
+		 */
+		inline MeshOptimizationReport optimizeValidMesh(MeshData& mesh, const MeshOptimizationSettings& settings)
+		{
+			MeshOptimizationReport report;
+			report.before = analyzeVertexCache(mesh.indices, mesh.getVertexCount(), settings.cacheSize);
+			report.vertexCountBefore = mesh.getVertexCount();
+
+			if (settings.deduplicateVertices)
+				deduplicateVertices(mesh);
+
+			if (settings.optimizeVertexCache)
+			{
+				const std::vector<GLuint> clusters = optimizeVertexCache(mesh.indices, mesh.getVertexCount(),
+					settings.cacheSize);
+
+				if (settings.optimizeOverdraw)
+					optimizeOverdraw(mesh, clusters, settings.cacheSize, settings.overdrawThreshold);
+			}
+
+			if (settings.optimizeVertexFetch)
+				optimizeVertexFetch(mesh);
+
+			report.after = analyzeVertexCache(mesh.indices, mesh.getVertexCount(), settings.cacheSize);
+			report.vertexCountAfter = mesh.getVertexCount();
+			return report;
+		}
+
+		inline void logMeshOptimization(const MeshOptimizationReport& report)
+		{
+			logInfoStart() << "Optimized mesh: ACMR " << report.before.acmr << " -> " << report.after.acmr <<
+				", ATVR " << report.before.atvr << " -> " << report.after.atvr << ", vertices " <<
+				report.vertexCountBefore << " -> " << report.vertexCountAfter << "." << logInfoEnd;
+		}
+	}
+
+	/**
+	 * @brief Run every enabled optimization pass on a mesh: vertex deduplication, vertex cache optimization, overdraw
+	 * optimization and vertex fetch optimization, in that order.
+	 * @param mesh The mesh to optimize.
+	 * @param settings Which passes to run and how.
+	 * @return ACMR/ATVR and vertex counts before and after optimization.
+	 * @throws ErrCode::InvalidMeshData If the mesh's index count isn't a multiple of 3, its vertex data isn't a
+	 * multiple of its stride, or any index is out of range.
+	 */
+	inline MeshOptimizationReport optimizeMesh(MeshData& mesh, const MeshOptimizationSettings& settings = {})
+	{
+		if (!detail::meshValid(mesh))
+			detail::throwErr(ErrCode::InvalidMeshData, "Attempted to optimize an invalid mesh.");
+
+		const MeshOptimizationReport report = detail::optimizeValidMesh(mesh, settings);
+		detail::logMeshOptimization(report);
+		return report;
+	}
+
+	/**
+	 * @brief Optimize many meshes in parallel. Each mesh is optimized as with optimizeMesh() on one of a pool of
+	 * worker threads. Only the calling thread logs, once the workers are done.
+	 * @param meshes The meshes to optimize.
+	 * @param settings Which passes to run and how, and how many threads to use.
+	 * @return One report per mesh, in the same order as the meshes.
+	 * @throws ErrCode::InvalidMeshData If any mesh is invalid. The remaining meshes are still optimized.
+	 */
+	inline std::vector<MeshOptimizationReport> optimizeMeshes(std::vector<MeshData>& meshes,
+		const MeshOptimizationSettings& settings = {})
+	{
+		std::vector<MeshOptimizationReport> reports(meshes.size());
+		std::vector<std::exception_ptr> errors(meshes.size());
+		// Not std::vector<bool>, whose elements can't be written from different threads.
+		std::vector<char> invalid(meshes.size(), 0);
+
+		detail::parallelFor(meshes.size(), settings.threadCount, [&](const std::size_t i)
+		{
+			if (!detail::meshValid(meshes[i]))
+			{
+				invalid[i] = 1;
+				return;
+			}
+
+			try
+			{
+				reports[i] = detail::optimizeValidMesh(meshes[i], settings);
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception();
+			}
+		});
+
+		for (std::size_t i = 0; i < meshes.size(); ++i)
+			if (!invalid[i] && !errors[i])
+				detail::logMeshOptimization(reports[i]);
+
+		for (const auto& error : errors)
+			if (error)
+				std::rethrow_exception(error);
+
+		if (std::find(invalid.begin(), invalid.end(), 1) != invalid.end())
+			detail::throwErr(ErrCode::InvalidMeshData, "Attempted to optimize an invalid mesh.");
+
+		return reports;
+	}
+}
+
+#endif //GAL_MESH_OPTIMIZER_HPP
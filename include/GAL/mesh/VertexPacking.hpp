@@ -0,0 +1,546 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_VERTEX_PACKING_HPP
+#define GAL_VERTEX_PACKING_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GAL_PACKING_SSE2
+#endif
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+namespace gal
+{
+	namespace detail
+	{
+		inline std::uint16_t floatToHalf(const float value) noexcept
+		{
+			std::uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			const std::uint32_t sign = (bits >> 16) & 0x8000u;
+			const std::uint32_t floatExponent = (bits >> 23) & 0xFFu;
+			std::uint32_t mantissa = bits & 0x7FFFFFu;
+			const std::int32_t exponent = static_cast<std::int32_t>(floatExponent) - 127 + 15;
+
+			if (floatExponent == 0xFFu) // Inf or NaN.
+				return static_cast<std::uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+			if (exponent >= 31) // Overflow.
+				return static_cast<std::uint16_t>(sign | 0x7C00u);
+
+			if (exponent <= 0) // Subnormal or zero.
+			{
+				if (exponent < -10)
+					return static_cast<std::uint16_t>(sign);
+
+				mantissa |= 0x800000u;
+				const auto shift = static_cast<std::uint32_t>(14 - exponent);
+				std::uint32_t half = mantissa >> shift;
+				const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+				const std::uint32_t midpoint = 1u << (shift - 1u);
+				if (remainder > midpoint || (remainder == midpoint && (half & 1u)))
+					++half;
+
+				return static_cast<std::uint16_t>(sign | half);
+			}
+
+			// Rounding may carry into the exponent, which is exactly what should happen.
+			std::uint32_t half = sign | static_cast<std::uint32_t>(exponent) << 10 | mantissa >> 13;
+			const std::uint32_t remainder = mantissa & 0x1FFFu;
+			if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+				++half;
+
+			return static_cast<std::uint16_t>(half);
+		}
+
+		inline float halfToFloat(const std::uint16_t half) noexcept
+		{
+			const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+			const std::uint32_t exponent = (half >> 10) & 0x1Fu;
+			const std::uint32_t mantissa = half & 0x3FFu;
+
+			if (exponent == 0)
+			{
+				const float value = std::ldexp(static_cast<float>(mantissa), -24);
+				return sign ? -value : value;
+			}
+
+			std::uint32_t bits;
+			if (exponent == 31)
+				bits = sign | 0x7F800000u | mantissa << 13;
+			else
+				bits = sign | (exponent - 15 + 127) << 23 | mantissa << 13;
+
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		// Scalar conversions round with std::lrint(), which rounds ties to even like _mm_cvtps_epi32() in the SIMD
+		// paths, so a value packs the same wherever it falls in a batch.
+		inline std::int16_t floatToSnorm16(const float value) noexcept
+		{
+			return static_cast<std::int16_t>(std::lrint(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+		}
+
+		inline std::uint8_t floatToUnorm8(const float value) noexcept
+		{
+			return static_cast<std::uint8_t>(std::lrint(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+		}
+	}
+
+	/**
+	 * @brief Convert floats to IEEE half floats (GL_HALF_FLOAT), rounding to nearest even.
+	 * @param src The floats to convert.
+	 * @param dst Where to write the half floats. Must have room for count elements.
+	 * @param count Number of floats to convert.
+	 */
+	inline void packHalf(const float* src, std::uint16_t* dst, const std::size_t count) noexcept
+	{
+		std::size_t i = 0;
+#ifdef __F16C__
+		for (; i + 4 <= count; i += 4)
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i),
+				_mm_cvtps_ph(_mm_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+		for (; i < count; ++i)
+			dst[i] = detail::floatToHalf(src[i]);
+	}
+
+	/**
+	 * @brief Convert half floats back to floats.
+	 * @param src The half floats to convert.
+	 * @param dst Where to write the floats. Must have room for count elements.
+	 * @param count Number of half floats to convert.
+	 */
+	inline void unpackHalf(const std::uint16_t* src, float* dst, const std::size_t count) noexcept
+	{
+		std::size_t i = 0;
+#ifdef __F16C__
+		for (; i + 4 <= count; i += 4)
+			_mm_storeu_ps(dst + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i))));
+#endif
+		for (; i < count; ++i)
+			dst[i] = detail::halfToFloat(src[i]);
+	}
+
+	/**
+	 * @brief Convert floats in [-1, 1] to normalized signed shorts (GL_SHORT, normalized). Values outside the range
+	 * are clamped.
+	 * @param src The floats to convert.
+	 * @param dst Where to write the shorts. Must have room for count elements.
+	 * @param count Number of floats to convert.
+	 */
+	inline void packSnorm16(const float* src, std::int16_t* dst, const std::size_t count) noexcept
+	{
+		std::size_t i = 0;
+#ifdef GAL_PACKING_SSE2
+		const __m128 min = _mm_set1_ps(-1.0f);
+		const __m128 max = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(32767.0f);
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m128 a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), min), max), scale);
+			const __m128 b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), min), max), scale);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+				_mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+		}
+#endif
+		for (; i < count; ++i)
+			dst[i] = detail::floatToSnorm16(src[i]);
+	}
+
+	/**
+	 * @brief Convert normalized signed shorts back to floats the same way OpenGL does.
+	 * @param src The shorts to convert.
+	 * @param dst Where to write the floats. Must have room for count elements.
+	 * @param count Number of shorts to convert.
+	 */
+	inline void unpackSnorm16(const std::int16_t* src, float* dst, const std::size_t count) noexcept
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			dst[i] = std::max(static_cast<float>(src[i]) / 32767.0f, -1.0f);
+	}
+
+	/**
+	 * @brief Convert floats in [0, 1] to normalized unsigned bytes (GL_UNSIGNED_BYTE, normalized). Values outside the
+	 * range are clamped.
+	 * @param src The floats to convert.
+	 * @param dst Where to write the bytes. Must have room for count elements.
+	 * @param count Number of floats to convert.
+	 */
+	inline void packUnorm8(const float* src, std::uint8_t* dst, const std::size_t count) noexcept
+	{
+		std::size_t i = 0;
+#ifdef GAL_PACKING_SSE2
+		const __m128 min = _mm_setzero_ps();
+		const __m128 max = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(255.0f);
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i quarters[4];
+			for (int q = 0; q < 4; ++q)
+				quarters[q] = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + q * 4), min),
+					max), scale));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(
+				_mm_packs_epi32(quarters[0], quarters[1]), _mm_packs_epi32(quarters[2], quarters[3])));
+		}
+#endif
+		for (; i < count; ++i)
+			dst[i] = detail::floatToUnorm8(src[i]);
+	}
+
+	/**
+	 * @brief Convert normalized unsigned bytes back to floats the same way OpenGL does.
+	 * @param src The bytes to convert.
+	 * @param dst Where to write the floats. Must have room for count elements.
+	 * @param count Number of bytes to convert.
+	 */
+	inline void unpackUnorm8(const std::uint8_t* src, float* dst, const std::size_t count) noexcept
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			dst[i] = static_cast<float>(src[i]) / 255.0f;
+	}
+
+	/**
+	 * @brief Encode unit vectors with an octahedral mapping into two normalized signed shorts each. Decode them in
+	 * GLSL with OCTAHEDRAL_DECODE_GLSL.
+	 * @param src The unit vectors to encode, as count * 3 floats.
+	 * @param dst Where to write the encoded vectors. Must have room for count * 2 elements.
+	 * @param count Number of vectors to encode.
+	 */
+	inline void packOctahedral(const float* src, std::int16_t* dst, const std::size_t count)
+	{
+		std::vector<float> encoded(count * 2);
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const float x = src[i * 3];
+			const float y = src[i * 3 + 1];
+			const float z = src[i * 3 + 2];
+			const float l1Norm = std::abs(x) + std::abs(y) + std::abs(z);
+
+			float u = l1Norm > 0.0f ? x / l1Norm : 0.0f;
+			float v = l1Norm > 0.0f ? y / l1Norm : 0.0f;
+			if (z < 0.0f)
+			{
+				const float foldedU = (1.0f - std::abs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+				const float foldedV = (1.0f - std::abs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+				u = foldedU;
+				v = foldedV;
+			}
+
+			encoded[i * 2] = u;
+			encoded[i * 2 + 1] = v;
+		}
+
+		packSnorm16(encoded.data(), dst, count * 2);
+	}
+
+	/**
+	 * @brief Decode octahedral encoded vectors back into unit vectors.
+	 * @param src The encoded vectors, as count * 2 shorts.
+	 * @param dst Where to write the decoded vectors. Must have room for count * 3 elements.
+	 * @param count Number of vectors to decode.
+	 */
+	inline void unpackOctahedral(const std::int16_t* src, float* dst, const std::size_t count)
+	{
+		std::vector<float> encoded(count * 2);
+		unpackSnorm16(src, encoded.data(), count * 2);
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			float x = encoded[i * 2];
+			float y = encoded[i * 2 + 1];
+			const float z = 1.0f - std::abs(x) - std::abs(y);
+			const float t = std::max(-z, 0.0f);
+			x += x >= 0.0f ? -t : t;
+			y += y >= 0.0f ? -t : t;
+
+			const float length = std::sqrt(x * x + y * y + z * z);
+			dst[i * 3] = x / length;
+			dst[i * 3 + 1] = y / length;
+			dst[i * 3 + 2] = z / length;
+		}
+	}
+
+	/**
+	 * @brief Pack 4-component vectors with xyz in [-1, 1] and w in {-1, 0, 1} (e.g., tangents with a handedness sign)
+	 * into GL_INT_2_10_10_10_REV, normalized.
+	 * @param src The vectors to pack, as count * 4 floats.
+	 * @param dst Where to write the packed vectors. Must have room for count elements.
+	 * @param count Number of vectors to pack.
+	 */
+	inline void packInt2101010Rev(const float* src, std::uint32_t* dst, const std::size_t count) noexcept
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const auto component = [&](const int c, const float scale, const std::uint32_t mask)
+			{
+				const long quantized = std::lrint(std::clamp(src[i * 4 + c], -1.0f, 1.0f) * scale);
+				return static_cast<std::uint32_t>(quantized) & mask;
+			};
+
+			dst[i] = component(0, 511.0f, 0x3FFu) | component(1, 511.0f, 0x3FFu) << 10 |
+				component(2, 511.0f, 0x3FFu) << 20 | component(3, 1.0f, 0x3u) << 30;
+		}
+	}
+
+	/**
+	 * @brief Unpack GL_INT_2_10_10_10_REV vectors back to floats the same way OpenGL does.
+	 * @param src The packed vectors.
+	 * @param dst Where to write the vectors. Must have room for count * 4 elements.
+	 * @param count Number of vectors to unpack.
+	 */
+	inline void unpackInt2101010Rev(const std::uint32_t* src, float* dst, const std::size_t count) noexcept
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const auto component = [&](const int shift, const int bits)
+			{
+				// Shift the field to the top of the word, then arithmetic shift back down to sign extend it.
+				const auto value = static_cast<std::int32_t>(src[i] << (32 - shift - bits)) >> (32 - bits);
+				return std::max(static_cast<float>(value) / static_cast<float>((1 << (bits - 1)) - 1), -1.0f);
+			};
+
+			dst[i * 4] = component(0, 10);
+			dst[i * 4 + 1] = component(10, 10);
+			dst[i * 4 + 2] = component(20, 10);
+			dst[i * 4 + 3] = component(30, 2);
+		}
+	}
+
+	/**
+	 * @brief GLSL function that decodes a normal packed with packOctahedral() and read through a vertex attribute set
+	 * up with VertexAttributePacking::OctahedralSnorm16 (i.e., as a normalized vec2).
+	 */
+	inline constexpr const char* OCTAHEDRAL_DECODE_GLSL =
+		"vec3 galDecodeOctahedral(vec2 e)\n"
+		"{\n"
+		"\tvec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));\n"
+		"\tfloat t = max(-v.z, 0.0);\n"
+		"\tv.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));\n"
+		"\treturn normalize(v);\n"
+		"}\n";
+
+	/**
+	 * @brief Get the size in bytes that an attribute takes up once packed.
+	 * @param packing How the attribute is packed.
+	 * @param components Number of float components in the unpacked attribute.
+	 */
+	[[nodiscard]] inline GLuint packedAttributeSize(const VertexAttributePacking packing, const GLint components) noexcept
+	{
+		switch (packing)
+		{
+			case VertexAttributePacking::Float32:          return components * 4;
+			case VertexAttributePacking::Half:             return components * 2;
+			case VertexAttributePacking::Snorm16:          return components * 2;
+			case VertexAttributePacking::Unorm8:           return components;
+			case VertexAttributePacking::OctahedralSnorm16: return 4;
+			case VertexAttributePacking::Int2101010Rev:    return 4;
+		}
+
+		return components * 4;
+	}
+
+	/**
+	 * @brief Round-trip error of a packed attribute.
+	 */
+	struct QuantizationErrorReport
+	{
+		/// Largest absolute error of any component, or largest angle in degrees for OctahedralSnorm16.
+		float maxError = 0.0f;
+		/// Mean absolute error over all components, or mean angle in degrees for OctahedralSnorm16.
+		float meanError = 0.0f;
+		/// Number of OctahedralSnorm16 vectors of zero length (or NaN), which have no direction to measure an angle
+		/// from and are left out of both errors.
+		std::size_t zeroLengthCount = 0;
+	};
+
+	/**
+	 * @brief An attribute of a float vertex to pack with packVertices().
+	 */
+	struct PackedAttribute
+	{
+		/// Byte offset of the attribute in the source vertex.
+		GLuint sourceOffset;
+		/// Number of floats in the source attribute. OctahedralSnorm16 requires 3, Int2101010Rev requires 4.
+		GLint components;
+		VertexAttributePacking packing;
+	};
+
+	/**
+	 * @brief The result of packVertices().
+	 */
+	struct PackedVertices
+	{
+		/// Interleaved packed vertices.
+		std::vector<std::byte> data;
+		/// Size of each packed vertex in bytes.
+		GLsizei stride = 0;
+		/// Byte offset of each attribute in the packed vertex, in the same order as the attributes were given. Pass
+		/// these to VertexArray::vertexAttributePackedFormat().
+		std::vector<GLuint> offsets;
+		/// Round-trip error of each attribute, in the same order as the attributes were given.
+		std::vector<QuantizationErrorReport> errors;
+	};
+
+	/**
+	 * @brief Convert interleaved float vertices into interleaved packed vertices, using SIMD where available. Each
+	 * packed attribute is aligned to 4 bytes.
+	 * @param src The float vertex data.
+	 * @param srcStride Size of each source vertex in bytes.
+	 * @param vertexCount Number of vertices to pack.
+	 * @param attributes How to pack each attribute.
+	 * @return The packed vertices, their layout, and the round-trip error of each attribute.
+	 * @throws ErrCode::InvalidMeshData If an attribute has no components, doesn't fit in the source stride, or has a
+	 * component count its packing doesn't support (OctahedralSnorm16 requires 3 and Int2101010Rev requires 4).
+	 */
+	inline PackedVertices packVertices(const void* src, const GLsizei srcStride, const std::size_t vertexCount,
+		const std::vector<PackedAttribute>& attributes)
+	{
+		for (const auto& attribute : attributes)
+		{
+			if (attribute.components <= 0 || srcStride <= 0 ||
+				attribute.sourceOffset + static_cast<std::size_t>(attribute.components) * sizeof(float) >
+				static_cast<std::size_t>(srcStride))
+			{
+				detail::logErrStart() << "Attribute at offset " << attribute.sourceOffset << " with " <<
+					attribute.components << " components doesn't fit in a source stride of " << srcStride << "." <<
+					detail::logErrEnd;
+				detail::throwErr(ErrCode::InvalidMeshData, "Attempted to pack an attribute outside the source vertex.");
+			}
+
+			if ((attribute.packing == VertexAttributePacking::OctahedralSnorm16 && attribute.components != 3) ||
+				(attribute.packing == VertexAttributePacking::Int2101010Rev && attribute.components != 4))
+			{
+				detail::logErrStart() << "Attribute at offset " << attribute.sourceOffset << " has " <<
+					attribute.components << " components, which its packing doesn't support." << detail::logErrEnd;
+				detail::throwErr(ErrCode::InvalidMeshData,
+					"Attempted to pack an attribute with a component count its packing doesn't support.");
+			}
+		}
+
+		PackedVertices result;
+
+		GLuint offset = 0;
+		for (const auto& attribute : attributes)
+		{
+			result.offsets.push_back(offset);
+			offset += (packedAttributeSize(attribute.packing, attribute.components) + 3) & ~3u;
+		}
+
+		result.stride = static_cast<GLsizei>(offset);
+		result.data.resize(vertexCount * offset);
+
+		const auto* srcBytes = static_cast<const std::byte*>(src);
+		std::vector<float> unpacked;
+		std::vector<float> roundTrip;
+		std::vector<std::byte> packed;
+
+		for (std::size_t a = 0; a < attributes.size(); ++a)
+		{
+			const PackedAttribute& attribute = attributes[a];
+			const auto components = static_cast<std::size_t>(attribute.components);
+			const GLuint packedSize = packedAttributeSize(attribute.packing, attribute.components);
+
+			// Gather the attribute into a tightly packed array so conversion can run over it in bulk.
+			unpacked.resize(vertexCount * components);
+			for (std::size_t v = 0; v < vertexCount; ++v)
+				std::memcpy(&unpacked[v * components], srcBytes + v * srcStride + attribute.sourceOffset,
+					components * sizeof(float));
+
+			roundTrip.resize(unpacked.size());
+			packed.resize(vertexCount * packedSize);
+			const std::size_t count = unpacked.size();
+
+			switch (attribute.packing)
+			{
+				case VertexAttributePacking::Float32:
+					std::memcpy(packed.data(), unpacked.data(), count * sizeof(float));
+					roundTrip = unpacked;
+					break;
+				case VertexAttributePacking::Half:
+					packHalf(unpacked.data(), reinterpret_cast<std::uint16_t*>(packed.data()), count);
+					unpackHalf(reinterpret_cast<const std::uint16_t*>(packed.data()), roundTrip.data(), count);
+					break;
+				case VertexAttributePacking::Snorm16:
+					packSnorm16(unpacked.data(), reinterpret_cast<std::int16_t*>(packed.data()), count);
+					unpackSnorm16(reinterpret_cast<const std::int16_t*>(packed.data()), roundTrip.data(), count);
+					break;
+				case VertexAttributePacking::Unorm8:
+					packUnorm8(unpacked.data(), reinterpret_cast<std::uint8_t*>(packed.data()), count);
+					unpackUnorm8(reinterpret_cast<const std::uint8_t*>(packed.data()), roundTrip.data(), count);
+					break;
+				case VertexAttributePacking::OctahedralSnorm16:
+					packOctahedral(unpacked.data(), reinterpret_cast<std::int16_t*>(packed.data()), vertexCount);
+					unpackOctahedral(reinterpret_cast<const std::int16_t*>(packed.data()), roundTrip.data(),
+						vertexCount);
+					break;
+				case VertexAttributePacking::Int2101010Rev:
+					packInt2101010Rev(unpacked.data(), reinterpret_cast<std::uint32_t*>(packed.data()), vertexCount);
+					unpackInt2101010Rev(reinterpret_cast<const std::uint32_t*>(packed.data()), roundTrip.data(),
+						vertexCount);
+					break;
+			}
+
+			QuantizationErrorReport& error = result.errors.emplace_back();
+			double errorSum = 0.0;
+
+			if (attribute.packing == VertexAttributePacking::OctahedralSnorm16)
+			{
+				for (std::size_t v = 0; v < vertexCount; ++v)
+				{
+					const glm::vec3 original{unpacked[v * 3], unpacked[v * 3 + 1], unpacked[v * 3 + 2]};
+					const float lengthSquared = glm::dot(original, original);
+					// Also catches NaN, so one bad normal can't make the whole report NaN.
+					if (!(lengthSquared > 0.0f))
+					{
+						++error.zeroLengthCount;
+						continue;
+					}
+
+					const glm::vec3 decoded{roundTrip[v * 3], roundTrip[v * 3 + 1], roundTrip[v * 3 + 2]};
+					const float cosine = std::clamp(glm::dot(original / std::sqrt(lengthSquared), decoded), -1.0f,
+						1.0f);
+					const float degrees = std::acos(cosine) * 57.29577951f;
+
+					error.maxError = std::max(error.maxError, degrees);
+					errorSum += degrees;
+				}
+
+				const std::size_t measured = vertexCount - error.zeroLengthCount;
+				error.meanError = measured ? static_cast<float>(errorSum / measured) : 0.0f;
+			}
+			else
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const float difference = std::abs(unpacked[i] - roundTrip[i]);
+					error.maxError = std::max(error.maxError, difference);
+					errorSum += difference;
+				}
+
+				error.meanError = count ? static_cast<float>(errorSum / count) : 0.0f;
+			}
+
+			for (std::size_t v = 0; v < vertexCount; ++v)
+				std::memcpy(&result.data[v * result.stride + result.offsets[a]], &packed[v * packedSize], packedSize);
+		}
+
+		return result;
+	}
+}
+
+#endif //GAL_VERTEX_PACKING_HPP
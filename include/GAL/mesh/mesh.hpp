@@ -0,0 +1,11 @@
+//
+// Created by kassie on 19/10/2026.
+//
+
+#ifndef GAL_MESH_HPP
+#define GAL_MESH_HPP
+
+#include "MeshOptimizer.hpp"
+#include "VertexPacking.hpp"
+
+#endif //GAL_MESH_HPP
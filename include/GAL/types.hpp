@@ -11,6 +11,7 @@ namespace gal
 
 	using BufferID = GLuint;
 	using ProgramID = GLuint;
+	using ProgramPipelineID = GLuint;
 	using ShaderID = GLuint;
 	using TextureID = GLuint;
 	using VertexArrayID = GLuint;